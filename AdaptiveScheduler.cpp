@@ -0,0 +1,108 @@
+/*
+ * Authors: 
+ *   Felix Brandt <brandt@fzi.de>, 
+ *   Jochen Speck <speck@kit.edu>, 
+ *   Markus Voelker <markus.voelker@kit.edu>
+ *
+ * Copyright (c) 2012 Felix Brandt, Jochen Speck, Markus Voelker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining 
+ * a copy of this software and associated documentation files (the 
+ * "Software"), to deal in the Software without restriction, including 
+ * without limitation the rights to use, copy, modify, merge, publish, 
+ * distribute, sublicense, and/or sell copies of the Software, and to 
+ * permit persons to whom the Software is furnished to do so, subject to 
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included 
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <algorithm>
+#include <time.h>
+
+#include "AdaptiveScheduler.h"
+
+AdaptiveScheduler::AdaptiveScheduler (double _decay, double _min_share, double _min_duration, double _max_duration) :
+decay(_decay), min_share(_min_share), min_duration(_min_duration), max_duration(_max_duration)
+{ }
+
+void AdaptiveScheduler::add (const SearchEntry& entry)
+{
+    entries.push_back(entry);
+}
+
+void AdaptiveScheduler::setSeed (unsigned long long seed, unsigned long long stream)
+{
+    random.seed(seed, stream);
+}
+
+SearchEntry& AdaptiveScheduler::get (int i)
+{
+    return entries[i];
+}
+
+int AdaptiveScheduler::select (int elapsed)
+{
+    std::vector<int> available;
+    double total = 0;
+    
+    for (unsigned int i = 0; i < entries.size(); ++i) {
+        const SearchEntry& se = entries[i];
+        
+        // skip search if not active or not within time constraints
+        if (!se.active || elapsed < se.start_time || (se.end_time >= 0 && elapsed > se.end_time))
+            continue;
+        
+        // strategies without a score yet go first
+        if (se.runs == 0)
+            return i;
+        
+        available.push_back(i);
+        total += se.score;
+    }
+    
+    if (available.empty())
+        return -1;
+    
+    // roulette on the scores, each strategy gets at least a share of the mean
+    double floor = total > 0 ? min_share * total / available.size() : 1.0;
+    double value = random.real() * (total + floor * available.size());
+    
+    for (unsigned int i = 0; i < available.size(); ++i) {
+        value -= entries[available[i]].score + floor;
+        if (value < 0)
+            return available[i];
+    }
+    return available.back();
+}
+
+void AdaptiveScheduler::update (int i, long long gain, double cpu_time)
+{
+    SearchEntry& se = entries[i];
+    double rate = std::max(0LL, gain) / std::max(cpu_time, 0.01);
+    
+    se.score = se.runs == 0 ? rate : decay * se.score + (1 - decay) * rate;
+    se.runs++;
+    
+    if (gain > 0) {
+        se.duration = std::min(se.duration * 1.5, max_duration);
+    } else {
+        se.duration = std::max(se.duration / 1.5, min_duration);
+    }
+}
+
+double AdaptiveScheduler::getThreadTime ()
+{
+    timespec now;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+}
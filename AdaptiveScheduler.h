@@ -0,0 +1,88 @@
+/*
+ * Authors: 
+ *   Felix Brandt <brandt@fzi.de>, 
+ *   Jochen Speck <speck@kit.edu>, 
+ *   Markus Voelker <markus.voelker@kit.edu>
+ *
+ * Copyright (c) 2012 Felix Brandt, Jochen Speck, Markus Voelker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining 
+ * a copy of this software and associated documentation files (the 
+ * "Software"), to deal in the Software without restriction, including 
+ * without limitation the rights to use, copy, modify, merge, publish, 
+ * distribute, sublicense, and/or sell copies of the Software, and to 
+ * permit persons to whom the Software is furnished to do so, subject to 
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included 
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#ifndef __ROADEF_ADAPTIVESCHEDULER_H__
+#define __ROADEF_ADAPTIVESCHEDULER_H__
+
+#include <string>
+#include <vector>
+
+#include "BaseSearch.h"
+
+struct SearchEntry {
+public:
+    SearchEntry(std::string _label, BaseSearch* _search, int _start_time, int _end_time, double _duration) : label(_label), search(_search), start_time(_start_time), end_time(_end_time), duration(_duration), active(true), score(0), runs(0) {};
+    
+    std::string label;
+    BaseSearch* search;
+    int start_time; // time after which search is started
+    int end_time; // time after which search is ended
+    double duration; // duration of one run in seconds, adapted by the scheduler
+    bool active; // flag to enable/disable the search strategy
+    double score; // decayed cost improvement per CPU second
+    unsigned int runs; // number of runs so far
+};
+
+/**
+ * Adaptive choice of the next search strategy of a thread. Every strategy
+ * is run once, afterwards strategies are drawn by roulette on their decayed
+ * improvement per CPU second. The duration of a run grows while a strategy
+ * improves and shrinks while it does not.
+ */
+class AdaptiveScheduler
+{
+protected:
+    std::vector<SearchEntry> entries;
+    
+    /** Weight of the previous score when a run is recorded */
+    double decay;
+    /** Share of the mean score every strategy gets, so that none starves */
+    double min_share;
+    double min_duration;
+    double max_duration;
+    
+    Random random;
+    
+public:
+    AdaptiveScheduler (double decay = 0.7, double min_share = 0.1, double min_duration = 0.1, double max_duration = 10);
+    
+    void add (const SearchEntry& entry);
+    void setSeed (unsigned long long seed, unsigned long long stream);
+    SearchEntry& get (int index);
+    
+    /** Strategy to run at the given number of seconds since the start, -1 if none is available */
+    int select (int elapsed);
+    /** Record the cost improvement and CPU time of a run */
+    void update (int index, long long gain, double cpu_time);
+    
+    /** CPU time of the calling thread in seconds */
+    static double getThreadTime ();
+};
+
+#endif /* __ROADEF_ADAPTIVESCHEDULER_H__ */
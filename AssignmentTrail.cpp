@@ -0,0 +1,428 @@
+/*
+ * Authors: 
+ *   Felix Brandt <brandt@fzi.de>, 
+ *   Jochen Speck <speck@kit.edu>, 
+ *   Markus Voelker <markus.voelker@kit.edu>
+ *
+ * Copyright (c) 2012 Felix Brandt, Jochen Speck, Markus Voelker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining 
+ * a copy of this software and associated documentation files (the 
+ * "Software"), to deal in the Software without restriction, including 
+ * without limitation the rights to use, copy, modify, merge, publish, 
+ * distribute, sublicense, and/or sell copies of the Software, and to 
+ * permit persons to whom the Software is furnished to do so, subject to 
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included 
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <algorithm>
+
+#include "AssignmentTrail.h"
+
+AssignmentTrail::AssignmentTrail () :
+instance(NULL), state(NULL),
+load_cost(0), balance_cost(0), process_moves(0), machine_moves(0)
+{ }
+
+void AssignmentTrail::reset (const ReAssignment& _state)
+{
+    if (instance != _state.instance) {
+        instance = _state.instance;
+        machine_slot.assign(instance->num_machines, -1);
+        process_slot.assign(instance->num_processes, -1);
+        service_slot.assign(instance->service.size(), -1);
+    } else {
+        // only clear the entries touched by the last run
+        for (std::vector<unsigned int>::const_iterator m = machines.begin(); m != machines.end(); ++m) {
+            machine_slot[*m] = -1;
+        }
+        for (std::vector<unsigned int>::const_iterator p = processes.begin(); p != processes.end(); ++p) {
+            process_slot[*p] = -1;
+        }
+        for (std::vector<ServiceCount>::const_iterator s = services.begin(); s != services.end(); ++s) {
+            service_slot[s->service] = -1;
+        }
+    }
+    
+    state = &_state;
+    machines.clear();
+    excess.clear();
+    transient.clear();
+    balance.clear();
+    processes.clear();
+    current.clear();
+    services.clear();
+    trail.clear();
+    
+    load_cost = state->load_cost;
+    balance_cost = state->balance_cost;
+    process_moves = state->process_moves;
+    machine_moves = state->machine_moves;
+}
+
+unsigned int AssignmentTrail::touchMachine (unsigned int machine)
+{
+    if (machine_slot[machine] < 0) {
+        machine_slot[machine] = (int)machines.size();
+        machines.push_back(machine);
+        excess.insert(excess.end(), state->excess[machine].begin(), state->excess[machine].end());
+        transient.insert(transient.end(), state->transient[machine].begin(), state->transient[machine].end());
+        balance.insert(balance.end(), state->balance[machine].begin(), state->balance[machine].end());
+    }
+    
+    return (unsigned int)machine_slot[machine];
+}
+
+unsigned int AssignmentTrail::touchService (unsigned int service)
+{
+    if (service_slot[service] < 0) {
+        service_slot[service] = (int)services.size();
+        services.push_back(ServiceCount());
+        
+        ServiceCount& count = services.back();
+        count.service = service;
+        count.unassigned = 0;
+        
+        const ProcessList& members = instance->service[service].process;
+        for (ProcessList::const_iterator p = members.begin(); p != members.end(); ++p) {
+            int m = getMachine(*p);
+            if (m < 0) {
+                count.unassigned++;
+            } else {
+                count.location[instance->machine[m].location]++;
+                count.neighborhood[instance->machine[m].neighborhood]++;
+            }
+        }
+        count.covered = (unsigned int)count.location.size();
+    }
+    
+    return (unsigned int)service_slot[service];
+}
+
+const int* AssignmentTrail::getExcess (unsigned int machine) const
+{
+    int s = machine_slot[machine];
+    return s < 0 ? &(state->excess[machine][0]) : &(excess[s * instance->num_resources]);
+}
+
+const int* AssignmentTrail::getTransient (unsigned int machine) const
+{
+    int s = machine_slot[machine];
+    if (instance->transient_count == 0) {
+        return NULL;
+    }
+    return s < 0 ? &(state->transient[machine][0]) : &(transient[s * instance->transient_count]);
+}
+
+const int* AssignmentTrail::getBalance (unsigned int machine) const
+{
+    int s = machine_slot[machine];
+    if (instance->balance.empty()) {
+        return NULL;
+    }
+    return s < 0 ? &(state->balance[machine][0]) : &(balance[s * instance->balance.size()]);
+}
+
+int AssignmentTrail::getMachine (unsigned int process) const
+{
+    int s = process_slot[process];
+    return s < 0 ? (int)state->assignment[process] : current[s];
+}
+
+long long AssignmentTrail::getCost () const
+{
+    return load_cost + balance_cost + process_moves * instance->weight_process_move_cost + machine_moves * instance->weight_machine_move_cost;
+}
+
+long long AssignmentTrail::getDelta (unsigned int p, unsigned int m) const
+{
+    const Process& process = instance->process[p];
+    const int* row = getExcess(m);
+    long long delta = 0;
+    
+    for (unsigned int r = 0; r < (unsigned int)instance->num_resources; ++r) {
+        delta += (std::max(0, row[r] + process.requirement[r]) - std::max(0, row[r])) * (long long)instance->resource[r].weight_load_cost;
+    }
+    
+    row = getBalance(m);
+    for (unsigned int b = 0; b < instance->balance.size(); ++b) {
+        const Balance& bal = instance->balance[b];
+        int process_balance = process.requirement[bal.resource2] - bal.balance * process.requirement[bal.resource1];
+        delta += (std::max(0, row[b] + process_balance) - std::max(0, row[b])) * (long long)bal.weight_balance_cost;
+    }
+    
+    if (process.original_machine != (int)m) {
+        delta += (long long)process.move_cost * instance->weight_process_move_cost;
+    }
+    delta += (long long)instance->machine[process.original_machine].move_cost[m] * instance->weight_machine_move_cost;
+    
+    return delta;
+}
+
+bool AssignmentTrail::fits (unsigned int p, unsigned int m) const
+{
+    const Process& process = instance->process[p];
+    const Machine& machine = instance->machine[m];
+    const int* row = getExcess(m);
+    
+    for (unsigned int r = 0; r < (unsigned int)instance->num_resources; ++r) {
+        if (row[r] + process.requirement[r] > machine.capacity[r] - machine.safety_capacity[r]) {
+            return false;
+        }
+    }
+    
+    // processes returning to their original machine are already part of the transient usage
+    if (process.original_machine != (int)m) {
+        row = getTransient(m);
+        for (unsigned int r = 0; r < instance->transient_count; ++r) {
+            if (row[r] + process.requirement[r] > machine.capacity[r]) {
+                return false;
+            }
+        }
+    }
+    
+    return true;
+}
+
+bool AssignmentTrail::conflicts (unsigned int p, unsigned int m) const
+{
+    const ProcessList& members = instance->service[instance->process[p].service].process;
+    
+    for (ProcessList::const_iterator q = members.begin(); q != members.end(); ++q) {
+        if (*q != p && getMachine(*q) == (int)m) {
+            return true;
+        }
+    }
+    
+    return false;
+}
+
+bool AssignmentTrail::spreads (unsigned int p, unsigned int m)
+{
+    unsigned int service = instance->process[p].service;
+    unsigned int min_spread = instance->service[service].min_spread;
+    
+    if (min_spread <= 1) {
+        return true;
+    }
+    
+    const ServiceCount& count = services[touchService(service)];
+    std::map<unsigned int, int>::const_iterator l = count.location.find(instance->machine[m].location);
+    
+    // every other lifted process may still add one location
+    unsigned int covered = count.covered + ((l == count.location.end() || l->second == 0) ? 1 : 0);
+    return covered + count.unassigned - 1 >= min_spread;
+}
+
+bool AssignmentTrail::valid ()
+{
+    // services with processes off their state machine, undone changes need no check
+    std::vector<unsigned int> changed;
+    for (unsigned int i = 0; i < processes.size(); ++i) {
+        if (current[i] != (int)state->assignment[processes[i]]) {
+            unsigned int service = instance->process[processes[i]].service;
+            if (std::find(changed.begin(), changed.end(), service) == changed.end()) {
+                changed.push_back(service);
+            }
+        }
+    }
+    
+    // count the related services first, adding entries later would move the maps under the iterators
+    for (std::vector<unsigned int>::const_iterator s = changed.begin(); s != changed.end(); ++s) {
+        const Service& service = instance->service[*s];
+        touchService(*s);
+        for (ServiceList::const_iterator d = service.depends_on.begin(); d != service.depends_on.end(); ++d) {
+            touchService(*d);
+        }
+        for (ServiceList::const_iterator d = service.required_by.begin(); d != service.required_by.end(); ++d) {
+            touchService(*d);
+        }
+    }
+    
+    for (std::vector<unsigned int>::const_iterator s = changed.begin(); s != changed.end(); ++s) {
+        const Service& service = instance->service[*s];
+        const ServiceCount& count = services[service_slot[*s]];
+        
+        if (count.covered < service.min_spread) {
+            return false;
+        }
+        
+        const std::map<unsigned int, int>& present = count.neighborhood;
+        
+        // all required services must be present where this service runs
+        for (std::map<unsigned int, int>::const_iterator n = present.begin(); n != present.end(); ++n) {
+            if (n->second == 0) {
+                continue;
+            }
+            
+            for (ServiceList::const_iterator d = service.depends_on.begin(); d != service.depends_on.end(); ++d) {
+                const std::map<unsigned int, int>& required = services[service_slot[*d]].neighborhood;
+                std::map<unsigned int, int>::const_iterator c = required.find(n->first);
+                if (c == required.end() || c->second == 0) {
+                    return false;
+                }
+            }
+        }
+        
+        // this service must still be present where its dependent services run
+        for (ServiceList::const_iterator d = service.required_by.begin(); d != service.required_by.end(); ++d) {
+            const std::map<unsigned int, int>& dependent = services[service_slot[*d]].neighborhood;
+            
+            for (std::map<unsigned int, int>::const_iterator n = dependent.begin(); n != dependent.end(); ++n) {
+                if (n->second == 0) {
+                    continue;
+                }
+                
+                std::map<unsigned int, int>::const_iterator c = present.find(n->first);
+                if (c == present.end() || c->second == 0) {
+                    return false;
+                }
+            }
+        }
+    }
+    
+    return true;
+}
+
+void AssignmentTrail::apply (unsigned int p, int from, int to)
+{
+    const Process& process = instance->process[p];
+    const Machine& original = instance->machine[process.original_machine];
+    unsigned int R = instance->num_resources;
+    unsigned int T = instance->transient_count;
+    unsigned int B = (unsigned int)instance->balance.size();
+    
+    if (from >= 0) {
+        unsigned int s = touchMachine(from);
+        int* row = &(excess[s * R]);
+        
+        for (unsigned int r = 0; r < R; ++r) {
+            load_cost += (std::max(0, row[r] - process.requirement[r]) - std::max(0, row[r])) * (long long)instance->resource[r].weight_load_cost;
+            row[r] -= process.requirement[r];
+        }
+        
+        if (process.original_machine != from) {
+            for (unsigned int r = 0; r < T; ++r) {
+                transient[s * T + r] -= process.requirement[r];
+            }
+            process_moves -= process.move_cost;
+        }
+        
+        for (unsigned int b = 0; b < B; ++b) {
+            const Balance& bal = instance->balance[b];
+            int process_balance = process.requirement[bal.resource2] - bal.balance * process.requirement[bal.resource1];
+            int& value = balance[s * B + b];
+            
+            balance_cost += (std::max(0, value - process_balance) - std::max(0, value)) * (long long)bal.weight_balance_cost;
+            value -= process_balance;
+        }
+        
+        machine_moves -= original.move_cost[from];
+    }
+    
+    if (to >= 0) {
+        unsigned int s = touchMachine(to);
+        int* row = &(excess[s * R]);
+        
+        for (unsigned int r = 0; r < R; ++r) {
+            load_cost += (std::max(0, row[r] + process.requirement[r]) - std::max(0, row[r])) * (long long)instance->resource[r].weight_load_cost;
+            row[r] += process.requirement[r];
+        }
+        
+        if (process.original_machine != to) {
+            for (unsigned int r = 0; r < T; ++r) {
+                transient[s * T + r] += process.requirement[r];
+            }
+            process_moves += process.move_cost;
+        }
+        
+        for (unsigned int b = 0; b < B; ++b) {
+            const Balance& bal = instance->balance[b];
+            int process_balance = process.requirement[bal.resource2] - bal.balance * process.requirement[bal.resource1];
+            int& value = balance[s * B + b];
+            
+            balance_cost += (std::max(0, value + process_balance) - std::max(0, value)) * (long long)bal.weight_balance_cost;
+            value += process_balance;
+        }
+        
+        machine_moves += original.move_cost[to];
+    }
+    
+    if (process_slot[p] < 0) {
+        process_slot[p] = (int)processes.size();
+        processes.push_back(p);
+        current.push_back(to);
+    } else {
+        current[process_slot[p]] = to;
+    }
+    
+    // keep the counts of services that are already tracked up to date
+    int c = service_slot[process.service];
+    if (c >= 0) {
+        ServiceCount& count = services[c];
+        
+        if (from >= 0) {
+            if (--count.location[instance->machine[from].location] == 0) {
+                count.covered--;
+            }
+            count.neighborhood[instance->machine[from].neighborhood]--;
+        } else {
+            count.unassigned--;
+        }
+        
+        if (to >= 0) {
+            if (++count.location[instance->machine[to].location] == 1) {
+                count.covered++;
+            }
+            count.neighborhood[instance->machine[to].neighborhood]++;
+        } else {
+            count.unassigned++;
+        }
+    }
+}
+
+void AssignmentTrail::lift (unsigned int p)
+{
+    int m = getMachine(p);
+    trail.push_back(Step(p, m));
+    apply(p, m, -1);
+}
+
+void AssignmentTrail::place (unsigned int p, unsigned int m)
+{
+    trail.push_back(Step(p, getMachine(p)));
+    apply(p, getMachine(p), (int)m);
+}
+
+void AssignmentTrail::undo (size_t mark)
+{
+    while (trail.size() > mark) {
+        Step step = trail.back();
+        trail.pop_back();
+        apply(step.process, getMachine(step.process), step.machine);
+    }
+}
+
+ReAssignment* AssignmentTrail::getResultState () const
+{
+    ReAssignment* result = new ReAssignment(*state);
+    
+    for (unsigned int i = 0; i < processes.size(); ++i) {
+        if (current[i] >= 0) {
+            result->move(processes[i], (unsigned int)current[i]);
+        }
+    }
+    
+    return result;
+}
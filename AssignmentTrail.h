@@ -0,0 +1,136 @@
+/*
+ * Authors: 
+ *   Felix Brandt <brandt@fzi.de>, 
+ *   Jochen Speck <speck@kit.edu>, 
+ *   Markus Voelker <markus.voelker@kit.edu>
+ *
+ * Copyright (c) 2012 Felix Brandt, Jochen Speck, Markus Voelker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining 
+ * a copy of this software and associated documentation files (the 
+ * "Software"), to deal in the Software without restriction, including 
+ * without limitation the rights to use, copy, modify, merge, publish, 
+ * distribute, sublicense, and/or sell copies of the Software, and to 
+ * permit persons to whom the Software is furnished to do so, subject to 
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included 
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#ifndef __ROADEF_ASSIGNMENTTRAIL_H__
+#define __ROADEF_ASSIGNMENTTRAIL_H__
+
+#include <map>
+#include <vector>
+
+#include "Instance.h"
+
+/**
+ * Incremental view of a solution state in which processes are lifted and
+ * placed again. Only the machines, processes and services touched since the
+ * last reset are stored, every change is recorded on a trail to be undone.
+ */
+class AssignmentTrail
+{
+protected:
+    /** Location and neighborhood usage of a service with changed processes */
+    struct ServiceCount {
+        unsigned int service;
+        /** Processes of the service currently lifted */
+        int unassigned;
+        /** Number of locations holding a process of the service */
+        unsigned int covered;
+        std::map<unsigned int, int> location;
+        std::map<unsigned int, int> neighborhood;
+    };
+    
+    /** Trail entry: a process and its machine before the change (-1 if lifted) */
+    struct Step {
+        unsigned int process;
+        int machine;
+        
+        Step (unsigned int _process, int _machine) : process(_process), machine(_machine) { }
+    };
+    
+    const Instance* instance;
+    const ReAssignment* state;
+    
+    /** Row of each machine in the overlay tables, -1 if the state rows apply */
+    std::vector<int> machine_slot;
+    std::vector<unsigned int> machines;
+    std::vector<int> excess;
+    std::vector<int> transient;
+    std::vector<int> balance;
+    
+    /** Entry of each process in the changed lists, -1 if never touched */
+    std::vector<int> process_slot;
+    std::vector<unsigned int> processes;
+    std::vector<int> current;
+    
+    /** Entry of each service in the service counts, -1 if not counted */
+    std::vector<int> service_slot;
+    std::vector<ServiceCount> services;
+    
+    std::vector<Step> trail;
+    
+    long long load_cost;
+    long long balance_cost;
+    long long process_moves;
+    long long machine_moves;
+    
+    /** Overlay row of a machine, created from the state on first use */
+    unsigned int touchMachine (unsigned int machine);
+    /** Count entry of a service, created from the current machines on first use */
+    unsigned int touchService (unsigned int service);
+    /** Move a process between machines (-1 for lifted) without recording it */
+    void apply (unsigned int process, int from, int to);
+    
+public:
+    AssignmentTrail ();
+    
+    /** Drop all changes and start over from the given state */
+    void reset (const ReAssignment& state);
+    
+    const Instance& getInstance () const { return *instance; }
+    const int* getExcess (unsigned int machine) const;
+    const int* getTransient (unsigned int machine) const;
+    const int* getBalance (unsigned int machine) const;
+    /** Current machine of a process, -1 if lifted */
+    int getMachine (unsigned int process) const;
+    /** Total cost of the current (partial) assignment */
+    long long getCost () const;
+    /** Cost change of placing a lifted process on a machine */
+    long long getDelta (unsigned int process, unsigned int machine) const;
+    /** Processes touched since the last reset */
+    const ProcessList& getChanged () const { return processes; }
+    
+    /** Capacity and transient usage check for a lifted process */
+    bool fits (unsigned int process, unsigned int machine) const;
+    /** Check whether another process of the same service runs on the machine */
+    bool conflicts (unsigned int process, unsigned int machine) const;
+    /** Check whether the service can still reach its minimum spread if the process is placed on the machine */
+    bool spreads (unsigned int process, unsigned int machine);
+    /** Check spread and dependencies of all services with changed processes (no process lifted) */
+    bool valid ();
+    
+    void lift (unsigned int process);
+    void place (unsigned int process, unsigned int machine);
+    size_t mark () const { return trail.size(); }
+    /** Revert all changes recorded after the mark */
+    void undo (size_t mark);
+    
+    /** Copy of the state with all changes applied */
+    ReAssignment* getResultState () const;
+};
+
+#endif /* __ROADEF_ASSIGNMENTTRAIL_H__ */
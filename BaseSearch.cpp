@@ -1,37 +1,78 @@
-/*
- * Authors: 
- *   Felix Brandt <brandt@fzi.de>, 
- *   Jochen Speck <speck@kit.edu>, 
- *   Markus Voelker <markus.voelker@kit.edu>
- *
- * Copyright (c) 2012 Felix Brandt, Jochen Speck, Markus Voelker
- *
- * Permission is hereby granted, free of charge, to any person obtaining 
- * a copy of this software and associated documentation files (the 
- * "Software"), to deal in the Software without restriction, including 
- * without limitation the rights to use, copy, modify, merge, publish, 
- * distribute, sublicense, and/or sell copies of the Software, and to 
- * permit persons to whom the Software is furnished to do so, subject to 
- * the following conditions:
- *
- * The above copyright notice and this permission notice shall be included 
- * in all copies or substantial portions of the Software.
- *
- * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
- * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
- * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
- * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
- * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
- * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
- * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
- */
-
-#include "BaseSearch.h"
-
-BaseSearch::BaseSearch (time_t _start_time)
-{
-    start_time = _start_time;
-}
-
-BaseSearch::~BaseSearch ()
-{ }
+/*
+ * Authors: 
+ *   Felix Brandt <brandt@fzi.de>, 
+ *   Jochen Speck <speck@kit.edu>, 
+ *   Markus Voelker <markus.voelker@kit.edu>
+ *
+ * Copyright (c) 2012 Felix Brandt, Jochen Speck, Markus Voelker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining 
+ * a copy of this software and associated documentation files (the 
+ * "Software"), to deal in the Software without restriction, including 
+ * without limitation the rights to use, copy, modify, merge, publish, 
+ * distribute, sublicense, and/or sell copies of the Software, and to 
+ * permit persons to whom the Software is furnished to do so, subject to 
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included 
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "BaseSearch.h"
+
+BaseSearch::BaseSearch (time_t _start_time) :
+incumbent(NULL), base_cost(0), fixing(NULL), costs(NULL)
+{
+    start_time = _start_time;
+}
+
+BaseSearch::~BaseSearch ()
+{ }
+
+void BaseSearch::setIncumbent (const Incumbent* _incumbent)
+{
+    incumbent = _incumbent;
+}
+
+void BaseSearch::setFixing (const ProcessFixing* _fixing)
+{
+    fixing = _fixing;
+}
+
+void BaseSearch::setCosts (ProcessCostIndex* _costs)
+{
+    costs = _costs;
+}
+
+void BaseSearch::setSeed (unsigned long long seed, unsigned long long stream)
+{
+    random.seed(seed, stream);
+}
+
+bool BaseSearch::interrupted () const
+{
+    return incumbent && incumbent->getCost() < base_cost;
+}
+
+bool BaseSearch::expired () const
+{
+    return budget.expired();
+}
+
+void BaseSearch::setBudget (const TimeBudget& _budget)
+{
+    budget = _budget;
+}
+
+double BaseSearch::getHelperTime () const
+{
+    return 0;
+}
@@ -1,55 +1,89 @@
-/*
- * Authors: 
- *   Felix Brandt <brandt@fzi.de>, 
- *   Jochen Speck <speck@kit.edu>, 
- *   Markus Voelker <markus.voelker@kit.edu>
- *
- * Copyright (c) 2012 Felix Brandt, Jochen Speck, Markus Voelker
- *
- * Permission is hereby granted, free of charge, to any person obtaining 
- * a copy of this software and associated documentation files (the 
- * "Software"), to deal in the Software without restriction, including 
- * without limitation the rights to use, copy, modify, merge, publish, 
- * distribute, sublicense, and/or sell copies of the Software, and to 
- * permit persons to whom the Software is furnished to do so, subject to 
- * the following conditions:
- *
- * The above copyright notice and this permission notice shall be included 
- * in all copies or substantial portions of the Software.
- *
- * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
- * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
- * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
- * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
- * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
- * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
- * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
- */
-
-#pragma once
-#ifndef __BASESEARCH_H__
-#define __BASESEARCH_H__
-
-#include <time.h>
-
-#include "Instance.h"
-#include "RescheduleSpace.h"
-
-/**
- * Base class for search strategies.
- */
-
-class BaseSearch
-{
-protected:
-    time_t start_time;
-    time_t time_limit;
-    
-public:
-    BaseSearch (time_t start_time);
-    virtual ~BaseSearch ();
-    
-    virtual ReAssignment* run(const ReAssignment* best_known, time_t time_limit) = 0;
-};
-
-#endif /* __BASESEARCH_H__ */
+/*
+ * Authors: 
+ *   Felix Brandt <brandt@fzi.de>, 
+ *   Jochen Speck <speck@kit.edu>, 
+ *   Markus Voelker <markus.voelker@kit.edu>
+ *
+ * Copyright (c) 2012 Felix Brandt, Jochen Speck, Markus Voelker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining 
+ * a copy of this software and associated documentation files (the 
+ * "Software"), to deal in the Software without restriction, including 
+ * without limitation the rights to use, copy, modify, merge, publish, 
+ * distribute, sublicense, and/or sell copies of the Software, and to 
+ * permit persons to whom the Software is furnished to do so, subject to 
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included 
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#ifndef __BASESEARCH_H__
+#define __BASESEARCH_H__
+
+#include <time.h>
+
+#include "Instance.h"
+#include "RescheduleSpace.h"
+#include "Incumbent.h"
+#include "Random.h"
+#include "ProcessFixing.h"
+#include "ProcessCostIndex.h"
+#include "TimeBudget.h"
+
+/**
+ * Base class for search strategies.
+ */
+
+class BaseSearch
+{
+protected:
+    time_t start_time;
+    /** Time of the current run */
+    TimeBudget budget;
+    
+    /** Solution shared with other threads, optional */
+    const Incumbent* incumbent;
+    /** Cost of the solution the current run started from */
+    long long base_cost;
+    /** Processes of the worker that must not be moved */
+    const ProcessFixing* fixing;
+    /** Cost reduction bounds of the worker's processes, shared by its searches */
+    ProcessCostIndex* costs;
+    /** Generator of this search, only drawn from by the thread running it */
+    Random random;
+    
+public:
+    BaseSearch (time_t start_time);
+    virtual ~BaseSearch ();
+    
+    /** End runs early once another thread publishes a solution cheaper than their start */
+    void setIncumbent (const Incumbent* incumbent);
+    /** Fixed processes of the worker running this search, required before the first run */
+    void setFixing (const ProcessFixing* fixing);
+    /** Cost index of the worker running this search, required before the first run of searches choosing processes by cost */
+    void setCosts (ProcessCostIndex* costs);
+    /** Whether the current run works on an outdated solution */
+    bool interrupted () const;
+    /** Whether the time of the current run is used up */
+    bool expired () const;
+    /** Limit the time of engines used without run, run sets its own budget */
+    void setBudget (const TimeBudget& budget);
+    /** Restart the generator, different streams of one seed give independent sequences */
+    void setSeed (unsigned long long seed, unsigned long long stream);
+    
+    virtual ReAssignment* run(const ReAssignment* best_known, const TimeBudget& budget) = 0;
+    /** CPU seconds other threads spent for the last run, 0 if the search runs on the calling thread only */
+    virtual double getHelperTime () const;
+};
+
+#endif /* __BASESEARCH_H__ */
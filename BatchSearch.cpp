@@ -0,0 +1,79 @@
+/*
+ * Authors: 
+ *   Felix Brandt <brandt@fzi.de>, 
+ *   Jochen Speck <speck@kit.edu>, 
+ *   Markus Voelker <markus.voelker@kit.edu>
+ *
+ * Copyright (c) 2012 Felix Brandt, Jochen Speck, Markus Voelker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining 
+ * a copy of this software and associated documentation files (the 
+ * "Software"), to deal in the Software without restriction, including 
+ * without limitation the rights to use, copy, modify, merge, publish, 
+ * distribute, sublicense, and/or sell copies of the Software, and to 
+ * permit persons to whom the Software is furnished to do so, subject to 
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included 
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "BatchSearch.h"
+
+BatchSearch::BatchSearch (int identifier, time_t start_time, int neighborhood_size, unsigned int _batch, TaskDeque* _queue) :
+RandomSearch(identifier, start_time, neighborhood_size), batch(_batch), queue(_queue)
+{ }
+
+BatchSearch::~BatchSearch ()
+{ }
+
+ReAssignment* BatchSearch::run (const ReAssignment* best_known, const TimeBudget& _budget)
+{
+    budget = _budget;
+    base_cost = best_known->getCost();
+    
+    // queue the whole batch first, so that other workers can help right away
+    costs->update(*best_known, *fixing);
+    unsigned int count = std::min((unsigned int)controller.scale(neighborhood), costs->getCount());
+    if (count == 0)
+        return NULL;
+    
+    NeighborhoodTask task;
+    task.deadline = budget;
+    for (unsigned int b = 0; b < batch; ++b) {
+        costs->sample(count, task.processes, random);
+        queue->push(task);
+    }
+    
+    // work off the newest tasks, thieves take the oldest ones
+    ReAssignment* best = NULL;
+    while (!expired() && !interrupted() && queue->pop(task)) {
+        ReAssignment* solution = reschedule(best ? *best : *best_known, task.processes);
+        if (solution) {
+            delete best;
+            best = solution;
+            
+            #ifdef LOGGING
+            std::cerr << identifier << " " << time(NULL) - start_time << " " << best->getCost() << std::endl;
+            #endif
+        }
+    }
+    
+    return best;
+}
+
+ReAssignment* BatchSearch::solve (const ReAssignment& state, const NeighborhoodTask& task, const TimeBudget& limit)
+{
+    budget = task.deadline.getDeadline() < limit.getDeadline() ? task.deadline : limit;
+    base_cost = state.getCost();
+    
+    return reschedule(state, task.processes);
+}
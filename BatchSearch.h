@@ -0,0 +1,59 @@
+/*
+ * Authors: 
+ *   Felix Brandt <brandt@fzi.de>, 
+ *   Jochen Speck <speck@kit.edu>, 
+ *   Markus Voelker <markus.voelker@kit.edu>
+ *
+ * Copyright (c) 2012 Felix Brandt, Jochen Speck, Markus Voelker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining 
+ * a copy of this software and associated documentation files (the 
+ * "Software"), to deal in the Software without restriction, including 
+ * without limitation the rights to use, copy, modify, merge, publish, 
+ * distribute, sublicense, and/or sell copies of the Software, and to 
+ * permit persons to whom the Software is furnished to do so, subject to 
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included 
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#ifndef __ROADEF_BATCHSEARCH_H__
+#define __ROADEF_BATCHSEARCH_H__
+
+#include "RandomSearch.h"
+#include "TaskDeque.h"
+
+/**
+ * Weighted random search that queues a batch of neighborhoods as tasks of
+ * its worker and then works them off. Idle workers steal the oldest tasks
+ * and solve them on their own solution, so a batch is shared by all workers
+ * that have nothing else to do.
+ */
+class BatchSearch : public RandomSearch
+{
+protected:
+    unsigned int batch;
+    /** Task deque of the worker running this search */
+    TaskDeque* queue;
+    
+public:
+    BatchSearch (int identifier, time_t start_time, int neighborhood_size, unsigned int batch, TaskDeque* queue);
+    virtual ~BatchSearch ();
+    
+    virtual ReAssignment* run (const ReAssignment* best_known, const TimeBudget& budget);
+    
+    /** Reschedule a queued or stolen task on the given state within its deadline and the limit, NULL if nothing better was found */
+    ReAssignment* solve (const ReAssignment& state, const NeighborhoodTask& task, const TimeBudget& limit);
+};
+
+#endif /* __ROADEF_BATCHSEARCH_H__ */
@@ -0,0 +1,192 @@
+/*
+ * Authors: 
+ *   Felix Brandt <brandt@fzi.de>, 
+ *   Jochen Speck <speck@kit.edu>, 
+ *   Markus Voelker <markus.voelker@kit.edu>
+ *
+ * Copyright (c) 2012 Felix Brandt, Jochen Speck, Markus Voelker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining 
+ * a copy of this software and associated documentation files (the 
+ * "Software"), to deal in the Software without restriction, including 
+ * without limitation the rights to use, copy, modify, merge, publish, 
+ * distribute, sublicense, and/or sell copies of the Software, and to 
+ * permit persons to whom the Software is furnished to do so, subject to 
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included 
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <algorithm>
+
+#include "CandidateMachines.h"
+
+CandidateMachines::CandidateMachines (unsigned int _count) :
+count(_count), instance(NULL), stamp(0), epoch(1), log_start(1)
+{ }
+
+void CandidateMachines::setCount (unsigned int _count)
+{
+    if (count != _count) {
+        count = _count;
+        // lists of the old length are rebuilt on their next use
+        log_start = ++epoch;
+        changes.clear();
+    }
+}
+
+void CandidateMachines::update (const ReAssignment& state)
+{
+    if (instance != state.instance) {
+        instance = state.instance;
+        stamp = state.stamp;
+        list.assign(instance->num_processes, std::vector<Entry>());
+        computed.assign(instance->num_processes, 0);
+        visited.assign(instance->num_machines, 0);
+        changes.clear();
+        log_start = ++epoch;
+        return;
+    }
+    
+    int first = state.findMoves(stamp);
+    stamp = state.stamp;
+    if (first < 0) {
+        // the moves are not known anymore, all lists are rebuilt on their next use
+        changes.clear();
+        log_start = ++epoch;
+        return;
+    }
+    
+    if (first < (int)state.journal.size()) {
+        epoch++;
+    }
+    for (unsigned int i = first; i < state.journal.size(); ++i) {
+        changes.push_back(std::pair<unsigned int, unsigned int>(epoch, state.journal[i].from));
+        changes.push_back(std::pair<unsigned int, unsigned int>(epoch, state.journal[i].to));
+    }
+    
+    // a long log is not cheaper than ranking all machines again
+    if (changes.size() > 4 * (size_t)instance->num_machines) {
+        changes.clear();
+        log_start = epoch;
+    }
+}
+
+bool CandidateMachines::getScore (const ReAssignment& state, unsigned int p, unsigned int m, long long& score) const
+{
+    const Process& process = instance->process[p];
+    const Machine& machine = instance->machine[m];
+    const MachineLoad& excess = state.excess[m];
+    
+    score = 0;
+    for (unsigned int r = 0; r < (unsigned int)instance->num_resources; ++r) {
+        if (excess[r] + process.requirement[r] > machine.capacity[r] - machine.safety_capacity[r]) {
+            return false;
+        }
+        if (r < instance->transient_count && process.original_machine != (int)m && state.transient[m][r] + process.requirement[r] > machine.capacity[r]) {
+            return false;
+        }
+        
+        score += (std::max(0, excess[r] + process.requirement[r]) - std::max(0, excess[r])) * (long long)instance->resource[r].weight_load_cost;
+    }
+    
+    if (process.original_machine != (int)m) {
+        score += (long long)process.move_cost * instance->weight_process_move_cost;
+    }
+    score += (long long)instance->machine[process.original_machine].move_cost[m] * instance->weight_machine_move_cost;
+    
+    return true;
+}
+
+void CandidateMachines::rebuild (const ReAssignment& state, unsigned int p)
+{
+    std::vector<Entry>& entries = list[p];
+    entries.clear();
+    
+    long long score;
+    for (unsigned int m = 0; m < (unsigned int)instance->num_machines; ++m) {
+        if (m != state.assignment[p] && getScore(state, p, m, score)) {
+            entries.push_back(Entry(score, m));
+        }
+    }
+    
+    if (entries.size() > count) {
+        std::partial_sort(entries.begin(), entries.begin() + count, entries.end());
+        entries.resize(count);
+    } else {
+        std::sort(entries.begin(), entries.end());
+    }
+}
+
+void CandidateMachines::refresh (const ReAssignment& state, unsigned int p)
+{
+    if (computed[p] == epoch) {
+        return;
+    }
+    
+    if (computed[p] < log_start) {
+        rebuild(state, p);
+        computed[p] = epoch;
+        return;
+    }
+    
+    std::vector<Entry>& entries = list[p];
+    std::vector<std::pair<unsigned int, unsigned int> >::const_iterator first = std::upper_bound(changes.begin(), changes.end(), std::pair<unsigned int, unsigned int>(computed[p], instance->num_machines));
+    
+    // a listed machine may have become worse, then an unlisted one could move up
+    for (std::vector<std::pair<unsigned int, unsigned int> >::const_iterator c = first; c != changes.end(); ++c) {
+        for (std::vector<Entry>::const_iterator e = entries.begin(); e != entries.end(); ++e) {
+            if (e->second == c->second) {
+                rebuild(state, p);
+                computed[p] = epoch;
+                return;
+            }
+        }
+    }
+    
+    // unlisted machines only compete through the changed ones
+    long long score;
+    for (std::vector<std::pair<unsigned int, unsigned int> >::const_iterator c = first; c != changes.end(); ++c) {
+        unsigned int m = c->second;
+        if (visited[m] == epoch) {
+            continue;
+        }
+        visited[m] = epoch;
+        
+        if (m != state.assignment[p] && getScore(state, p, m, score)) {
+            entries.push_back(Entry(score, m));
+        }
+    }
+    
+    std::sort(entries.begin(), entries.end());
+    if (entries.size() > count) {
+        entries.resize(count);
+    }
+    
+    // the markers are reused by the next process of this epoch
+    for (std::vector<std::pair<unsigned int, unsigned int> >::const_iterator c = first; c != changes.end(); ++c) {
+        visited[c->second] = 0;
+    }
+    
+    computed[p] = epoch;
+}
+
+void CandidateMachines::getDomain (const ReAssignment& state, unsigned int p, ProcessList& domain)
+{
+    refresh(state, p);
+    
+    domain.clear();
+    domain.push_back(state.assignment[p]);
+    for (std::vector<Entry>::const_iterator e = list[p].begin(); e != list[p].end(); ++e) {
+        domain.push_back(e->second);
+    }
+}
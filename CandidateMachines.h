@@ -0,0 +1,87 @@
+/*
+ * Authors: 
+ *   Felix Brandt <brandt@fzi.de>, 
+ *   Jochen Speck <speck@kit.edu>, 
+ *   Markus Voelker <markus.voelker@kit.edu>
+ *
+ * Copyright (c) 2012 Felix Brandt, Jochen Speck, Markus Voelker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining 
+ * a copy of this software and associated documentation files (the 
+ * "Software"), to deal in the Software without restriction, including 
+ * without limitation the rights to use, copy, modify, merge, publish, 
+ * distribute, sublicense, and/or sell copies of the Software, and to 
+ * permit persons to whom the Software is furnished to do so, subject to 
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included 
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#ifndef __ROADEF_CANDIDATEMACHINES_H__
+#define __ROADEF_CANDIDATEMACHINES_H__
+
+#include <vector>
+
+#include "Instance.h"
+
+/**
+ * The K cheapest feasible target machines per process, ranked by excess
+ * load and move cost. Lists are computed on first use and refreshed lazily:
+ * the machines changed since a list was built are found in a change log
+ * (filled from the journal moves of the states passed to update), only those are
+ * rescored unless one of them is part of the list.
+ */
+class CandidateMachines
+{
+protected:
+    typedef std::pair<long long, unsigned int> Entry;
+    
+    /** Number of machines per list (K) */
+    unsigned int count;
+    const Instance* instance;
+    /** Stamp of the solution the change log is based on */
+    unsigned long long stamp;
+    
+    /** Counter increased by every update that changes the assignment */
+    unsigned int epoch;
+    /** Oldest epoch still covered by the change log */
+    unsigned int log_start;
+    /** Machines changed per epoch, ordered by epoch */
+    std::vector<std::pair<unsigned int, unsigned int> > changes;
+    
+    /** Candidate list and its epoch per process (0 if never computed) */
+    std::vector<std::vector<Entry> > list;
+    std::vector<unsigned int> computed;
+    /** Scratch marker to visit each changed machine once */
+    std::vector<unsigned int> visited;
+    
+    /** Excess and move cost of adding a process to a machine, false if it does not fit */
+    bool getScore (const ReAssignment& state, unsigned int process, unsigned int machine, long long& score) const;
+    /** Rank all machines for a process */
+    void rebuild (const ReAssignment& state, unsigned int process);
+    /** Bring the list of a process up to date with the state */
+    void refresh (const ReAssignment& state, unsigned int process);
+    
+public:
+    CandidateMachines (unsigned int count = 0);
+    
+    void setCount (unsigned int count);
+    unsigned int getCount () const { return count; }
+    
+    /** Record the machines changed since the last update */
+    void update (const ReAssignment& state);
+    /** Candidate machines of a process plus its current machine, @c state has to be the one of the last update */
+    void getDomain (const ReAssignment& state, unsigned int process, ProcessList& domain);
+};
+
+#endif /* __ROADEF_CANDIDATEMACHINES_H__ */
@@ -0,0 +1,279 @@
+/*
+ * Authors: 
+ *   Felix Brandt <brandt@fzi.de>, 
+ *   Jochen Speck <speck@kit.edu>, 
+ *   Markus Voelker <markus.voelker@kit.edu>
+ *
+ * Copyright (c) 2012 Felix Brandt, Jochen Speck, Markus Voelker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining 
+ * a copy of this software and associated documentation files (the 
+ * "Software"), to deal in the Software without restriction, including 
+ * without limitation the rights to use, copy, modify, merge, publish, 
+ * distribute, sublicense, and/or sell copies of the Software, and to 
+ * permit persons to whom the Software is furnished to do so, subject to 
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included 
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include <set>
+#include <algorithm>
+
+#include "DependencyPropagator.h"
+
+using namespace Gecode;
+using namespace std;
+
+DependencyPropagator::DependencyPropagator (Home home, ViewArray<Int::IntView>& dependent, ViewArray<Int::IntView>& required, const std::vector<bool>& covered, const std::vector<bool>& demand) :
+Propagator(home),
+m_dependent(dependent), m_required(required),
+m_neighborhoods((unsigned int)covered.size())
+{
+    m_covered = static_cast<Space&>(home).alloc<bool>(m_neighborhoods);
+    m_demand = static_cast<Space&>(home).alloc<bool>(m_neighborhoods);
+    std::copy(covered.begin(), covered.end(), m_covered);
+    std::copy(demand.begin(), demand.end(), m_demand);
+    
+    m_dependent.subscribe(home, *this, Int::PC_INT_VAL);
+    m_required.subscribe(home, *this, Int::PC_INT_DOM);
+}
+
+DependencyPropagator::DependencyPropagator (Home home, bool share, DependencyPropagator& p) :
+Propagator(home, share, p),
+m_neighborhoods(p.m_neighborhoods)
+{
+    m_dependent.update(home, share, p.m_dependent);
+    m_required.update(home, share, p.m_required);
+    
+    m_covered = static_cast<Space&>(home).alloc<bool>(m_neighborhoods);
+    m_demand = static_cast<Space&>(home).alloc<bool>(m_neighborhoods);
+    std::copy(p.m_covered, p.m_covered + m_neighborhoods, m_covered);
+    std::copy(p.m_demand, p.m_demand + m_neighborhoods, m_demand);
+}
+
+DependencyPropagator* DependencyPropagator::copy (Space& home, bool share)
+{
+    return new (home) DependencyPropagator(home, share, *this);
+}
+
+size_t DependencyPropagator::dispose (Space& home)
+{
+    m_dependent.cancel(home, *this, Int::PC_INT_VAL);
+    m_required.cancel(home, *this, Int::PC_INT_DOM);
+    
+    (void) Propagator::dispose(home);
+    
+    return sizeof(*this);
+}
+
+PropCost DependencyPropagator::cost (const Space& home, const ModEventDelta& delta) const
+{
+    return PropCost::linear(PropCost::HI, m_dependent.size() + m_required.size());
+}
+
+ModEvent DependencyPropagator::restrictTo (Space& home, Int::IntView& view, unsigned int neighborhood)
+{
+    const Instance& instance = static_cast<RescheduleSpace&>(home).instance;
+    ProcessList blacklist;
+    
+    for (Int::ViewValues<Int::IntView> m(view); m(); ++m) {
+        if (instance.machine[m.val()].neighborhood != neighborhood) {
+            blacklist.push_back(m.val());
+        }
+    }
+    
+    ModEvent me = Int::ME_INT_DOM;
+    for (ProcessList::const_iterator iter = blacklist.begin(); iter != blacklist.end() && me >= 0; ++iter) {
+        me = view.nq(home, (int)(*iter));
+    }
+    
+    return me;
+}
+
+ExecStatus DependencyPropagator::propagate (Space& home, const ModEventDelta& delta)
+{
+    const Instance& instance = static_cast<RescheduleSpace&>(home).instance;
+    Region region(home);
+    
+    // number of unassigned required processes that can still reach a neighborhood and the last of them
+    int* reach = region.alloc<int>(m_neighborhoods);
+    int* candidate = region.alloc<int>(m_neighborhoods);
+    // neighborhoods covered by assigned required processes
+    bool* covered = region.alloc<bool>(m_neighborhoods);
+    
+    for (unsigned int n = 0; n < m_neighborhoods; ++n) {
+        reach[n] = 0;
+        candidate[n] = -1;
+        covered[n] = m_covered[n];
+    }
+    
+    int unassigned = 0;
+    for (int j = 0; j < m_required.size(); ++j) {
+        if (m_required[j].assigned()) {
+            covered[instance.machine[m_required[j].val()].neighborhood] = true;
+            continue;
+        }
+        
+        unassigned++;
+        for (Int::ViewValues<Int::IntView> m(m_required[j]); m(); ++m) {
+            unsigned int n = instance.machine[m.val()].neighborhood;
+            if (candidate[n] != j) {
+                candidate[n] = j;
+                reach[n]++;
+            }
+        }
+    }
+    
+    // neighborhoods that still need a required process: staying and assigned dependent processes
+    bool* demand = region.alloc<bool>(m_neighborhoods);
+    std::copy(m_demand, m_demand + m_neighborhoods, demand);
+    
+    bool subsumed = unassigned == 0;
+    for (int i = 0; i < m_dependent.size(); ++i) {
+        if (m_dependent[i].assigned()) {
+            demand[instance.machine[m_dependent[i].val()].neighborhood] = true;
+        } else {
+            subsumed = false;
+        }
+    }
+    
+    bool modified = false;
+    int open = 0;
+    
+    for (unsigned int n = 0; n < m_neighborhoods; ++n) {
+        if (!demand[n] || covered[n]) {
+            continue;
+        }
+        
+        if (reach[n] == 0) {
+            return ES_FAILED;
+        }
+        
+        // a single required process is left to cover this neighborhood
+        if (reach[n] == 1) {
+            GECODE_ME_CHECK(restrictTo(home, m_required[candidate[n]], n));
+            modified = true;
+        }
+        
+        open++;
+    }
+    
+    // each unassigned required process covers at most one of the open neighborhoods
+    if (open > unassigned) {
+        return ES_FAILED;
+    }
+    
+    if (subsumed) {
+        return home.ES_SUBSUMED(*this);
+    }
+    
+    // dependent processes may only go where the required service is or still can be
+    for (int i = 0; i < m_dependent.size(); ++i) {
+        if (m_dependent[i].assigned()) {
+            continue;
+        }
+        
+        ProcessList blacklist;
+        for (Int::ViewValues<Int::IntView> m(m_dependent[i]); m(); ++m) {
+            unsigned int n = instance.machine[m.val()].neighborhood;
+            if (!covered[n] && reach[n] == 0) {
+                blacklist.push_back(m.val());
+            }
+        }
+        
+        for (ProcessList::const_iterator iter = blacklist.begin(); iter != blacklist.end(); ++iter) {
+            GECODE_ME_CHECK(m_dependent[i].nq(home, (int)(*iter)));
+            modified = true;
+        }
+    }
+    
+    return modified ? ES_NOFIX : ES_FIX;
+}
+
+ExecStatus DependencyPropagator::post (Gecode::Home home, unsigned int dependent, unsigned int required, const std::vector<unsigned int>& dependent_index, const std::vector<unsigned int>& required_index)
+{
+    if (home.failed()) {
+        return ES_FAILED;
+    }
+    
+    RescheduleSpace& space = static_cast<RescheduleSpace&>((Space&)(home));
+    const Instance& instance = space.instance;
+    std::set<unsigned int> moved(space.moved.begin(), space.moved.end());
+    
+    // neighborhoods covered by the staying required processes
+    std::vector<bool> covered(instance.neighborhood.size(), false);
+    unsigned int num_covered = 0;
+    
+    const ProcessList& required_p = instance.service[required].process;
+    for (ProcessList::const_iterator p = required_p.begin(); p != required_p.end(); ++p) {
+        unsigned int n = instance.machine[space.state.assignment[*p]].neighborhood;
+        if (moved.find(*p) == moved.end() && !covered[n]) {
+            covered[n] = true;
+            num_covered++;
+        }
+    }
+    
+    // all neighborhoods present => nothing to check
+    if (num_covered == covered.size()) {
+        return ES_OK;
+    }
+    
+    // neighborhoods of staying dependent processes that lose their required process if it moves away
+    std::vector<bool> demand(instance.neighborhood.size(), false);
+    bool has_demand = false;
+    
+    const ProcessList& dependent_p = instance.service[dependent].process;
+    for (ProcessList::const_iterator p = dependent_p.begin(); p != dependent_p.end(); ++p) {
+        unsigned int n = instance.machine[space.state.assignment[*p]].neighborhood;
+        if (moved.find(*p) == moved.end() && !covered[n]) {
+            demand[n] = true;
+            has_demand = true;
+        }
+    }
+    
+    if (!has_demand && dependent_index.empty()) {
+        return ES_OK;
+    }
+    
+    // the required service stays where it is, just limit the dependent processes to its neighborhoods
+    if (required_index.empty()) {
+        std::vector<int> machines;
+        for (unsigned int n = 0; n < covered.size(); ++n) {
+            if (covered[n]) {
+                machines.insert(machines.end(), instance.neighborhood[n].begin(), instance.neighborhood[n].end());
+            }
+        }
+        std::sort(machines.begin(), machines.end());
+        
+        IntSet available_machines(&(machines[0]), (int)machines.size());
+        for (unsigned int i = 0; i < dependent_index.size(); ++i) {
+            dom(home, space.process[dependent_index[i]], available_machines);
+        }
+        return ES_OK;
+    }
+    
+    ViewArray<Int::IntView> dependent_view(space, (int)dependent_index.size());
+    for (unsigned int i = 0; i < dependent_index.size(); ++i) {
+        dependent_view[i] = Int::IntView(space.process[dependent_index[i]]);
+    }
+    
+    ViewArray<Int::IntView> required_view(space, (int)required_index.size());
+    for (unsigned int i = 0; i < required_index.size(); ++i) {
+        required_view[i] = Int::IntView(space.process[required_index[i]]);
+    }
+    
+    new (home) DependencyPropagator (home, dependent_view, required_view, covered, demand);
+    
+    return ES_OK;
+}
@@ -26,57 +26,55 @@
  * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
 
+
 #pragma once
-#ifndef __ROADEF_COSTPROPAGATOR_H__
-#define __ROADEF_COSTPROPAGATOR_H__
+#ifndef __ROADEF_DEPENDENCYPROPAGATOR_H__
+#define __ROADEF_DEPENDENCYPROPAGATOR_H__
+
+#include <vector>
 
 #include <gecode/int.hh>
 #include "Instance.h"
 #include "RescheduleSpace.h"
 
 /**
- * Adjust cost and balance variables and space delta.
+ * Keep every neighborhood hosting a process of a dependent service covered
+ * by the required service. Moved processes of both services are considered,
+ * so they can relocate together.
  */
-class CostPropagator : public Gecode::Propagator
+class DependencyPropagator : public Gecode::Propagator
 {
 protected:
-    /** Index of variables associated with considered process */
-    unsigned int m_index;
-    /** Id of the considered process */
-    unsigned int m_process_id;
-    /** Machine the process is assigned to */
-    Gecode::Int::IntView m_process;
-    /** Excess load for this single process */
-    Gecode::Int::IntView m_cost;
-    /** Index of last cached machine from the space's modified_machines */
-    int cache_stage;
-    /** Last checked cost bound */
-    std::pair<int, int> m_lastbound;
+    /** Machines of the moved processes of the dependent service */
+    Gecode::ViewArray<Gecode::Int::IntView> m_dependent;
+    /** Machines of the moved processes of the required service */
+    Gecode::ViewArray<Gecode::Int::IntView> m_required;
+    /** Number of neighborhoods */
+    unsigned int m_neighborhoods;
+    /** Neighborhoods covered by staying processes of the required service */
+    bool* m_covered;
+    /** Neighborhoods of staying dependent processes that are not covered yet */
+    bool* m_demand;
     
-    std::pair<int, int> initCache (RescheduleSpace& space, ProcessList& blacklist);
-    std::pair<int, int> updateCache (RescheduleSpace& space, ProcessList& blacklist, int cache_pos, bool need_sweep = false);
-    
-    std::pair<int, int> getAdditionalCost(const RescheduleSpace& space, const Process& process, unsigned int machine_id);
-    int getExcessCost (const RescheduleSpace& space, const Process& process, unsigned int machine_id, const Machine& machine, const MachineLoad& load, const MachineLoad& transient, const MachinePatch* patch = NULL);
-    std::pair<int, int> getBalanceCost (const RescheduleSpace& space, const Process& process, const Machine& machine, const MachineBalance& balance, const MachinePatch* patch = NULL);
+    /** Remove all machines outside of the given neighborhood */
+    Gecode::ModEvent restrictTo (Gecode::Space& home, Gecode::Int::IntView& view, unsigned int neighborhood);
     
 public:
     /** Initializing constructor */
-    CostPropagator (Gecode::Home home, unsigned int index, unsigned int process_id, Gecode::IntVar& process, Gecode::IntVar& cost);
+    DependencyPropagator (Gecode::Home home, Gecode::ViewArray<Gecode::Int::IntView>& dependent, Gecode::ViewArray<Gecode::Int::IntView>& required, const std::vector<bool>& covered, const std::vector<bool>& demand);
     /** Copy constructor for Gecode search */
-    CostPropagator (Gecode::Home home, bool share, CostPropagator& p);
+    DependencyPropagator (Gecode::Home home, bool share, DependencyPropagator& p);
     
     /** Propagator copying for Gecode search */
-    virtual CostPropagator* copy (Gecode::Space& home, bool share);
+    virtual DependencyPropagator* copy (Gecode::Space& home, bool share);
     /** Propagator destruction for Gecode search */
     virtual size_t dispose (Gecode::Space& home);
-    /** Just return constant execution cost */
+    /** Linear in the number of moved processes */
     virtual Gecode::PropCost cost (const Gecode::Space& home, const Gecode::ModEventDelta& delta) const;
     /** Propagate */
     virtual Gecode::ExecStatus propagate (Gecode::Space& home, const Gecode::ModEventDelta& delta);
-    /** Setup method */
-    static Gecode::ExecStatus post (Gecode::Home home, unsigned int index, unsigned int process);
+    /** Setup method for service @c dependent depending on service @c required, given the moved indices of their processes */
+    static Gecode::ExecStatus post (Gecode::Home home, unsigned int dependent, unsigned int required, const std::vector<unsigned int>& dependent_index, const std::vector<unsigned int>& required_index);
 };
 
-
-#endif /* __ROADEF_COSTPROPAGATOR_H__ */
+#endif /* __ROADEF_DEPENDENCYPROPAGATOR_H__ */
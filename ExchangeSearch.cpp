@@ -0,0 +1,187 @@
+/*
+ * Authors: 
+ *   Felix Brandt <brandt@fzi.de>, 
+ *   Jochen Speck <speck@kit.edu>, 
+ *   Markus Voelker <markus.voelker@kit.edu>
+ *
+ * Copyright (c) 2012 Felix Brandt, Jochen Speck, Markus Voelker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining 
+ * a copy of this software and associated documentation files (the 
+ * "Software"), to deal in the Software without restriction, including 
+ * without limitation the rights to use, copy, modify, merge, publish, 
+ * distribute, sublicense, and/or sell copies of the Software, and to 
+ * permit persons to whom the Software is furnished to do so, subject to 
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included 
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <algorithm>
+
+#include "ExchangeSearch.h"
+
+ExchangeSearch::ExchangeSearch (int identifier, time_t start_time, unsigned int _size, unsigned int _targets, unsigned int _width) :
+IterativeSearch(identifier, start_time),
+size(_size), targets(_targets), width(_width), last(0),
+best_cost(0), evaluations(0)
+{ }
+
+ExchangeSearch::~ExchangeSearch ()
+{ }
+
+void ExchangeSearch::getWindow (ProcessList& window) const
+{
+    ProcessCostIndex::Cursor cursor(*costs);
+    ProcessCost next;
+    unsigned int rank = 0;
+    
+    window.clear();
+    while (window.size() < width && cursor.next(next) && next.cost > 0) {
+        if (rank++ >= last) {
+            window.push_back(next.index);
+        }
+    }
+}
+
+void ExchangeSearch::getCandidates (const ReAssignment& state, unsigned int p, ProcessList& machines)
+{
+    // the domain starts with the current machine
+    candidates.getDomain(state, p, machines);
+    machines.erase(machines.begin());
+}
+
+void ExchangeSearch::evaluate (const Move* move, unsigned int count)
+{
+    evaluations++;
+    size_t mark = trail.mark();
+    
+    for (unsigned int i = 0; i < count; ++i) {
+        trail.lift(move[i].first);
+    }
+    
+    bool feasible = true;
+    for (unsigned int i = 0; feasible && i < count; ++i) {
+        if (trail.fits(move[i].first, move[i].second) && !trail.conflicts(move[i].first, move[i].second)) {
+            trail.place(move[i].first, move[i].second);
+        } else {
+            feasible = false;
+        }
+    }
+    
+    // spread and dependencies are only checked for improving exchanges
+    if (feasible && trail.getCost() < best_cost && trail.valid()) {
+        best_cost = trail.getCost();
+        best_move.assign(move, move + count);
+    }
+    
+    trail.undo(mark);
+}
+
+ReAssignment* ExchangeSearch::runOnce (const ReAssignment* state)
+{
+    costs->update(*state, *fixing);
+    candidates.setCount(targets);
+    candidates.update(*state);
+    
+    // the sweep wraps around after the last process with a positive reduction
+    ProcessList window;
+    getWindow(window);
+    if (window.empty() && last > 0) {
+        last = 0;
+        getWindow(window);
+    }
+    
+    if (window.empty()) {
+        return NULL;
+    }
+    
+    trail.reset(*state);
+    best_move.clear();
+    best_cost = trail.getCost();
+    
+    Move move[3];
+    
+    // polled per target machine and per swap partner, a single process may take many thousand evaluations
+    bool stopped = false;
+    
+    ProcessList target;
+    ProcessList next;
+    for (unsigned int w = 0; w < window.size() && !stopped; ++w) {
+        unsigned int p = window[w];
+        unsigned int home = state->assignment[p];
+        getCandidates(*state, p, target);
+        
+        for (ProcessList::const_iterator m = target.begin(); m != target.end() && !(stopped = expired() || interrupted()); ++m) {
+            move[0] = Move(p, *m);
+            
+            // shift
+            evaluate(move, 1);
+            
+            if (size < 2) {
+                continue;
+            }
+            
+            const ProcessList& hosted = costs->getProcesses(*m);
+            for (ProcessList::const_iterator q = hosted.begin(); q != hosted.end() && !(stopped = expired() || interrupted()); ++q) {
+                if (fixing->fixed[*q]) {
+                    continue;
+                }
+                
+                // swap
+                move[1] = Move(*q, home);
+                evaluate(move, 2);
+                
+                if (size < 3) {
+                    continue;
+                }
+                
+                // rotation p -> m, q -> m2, r -> home
+                getCandidates(*state, *q, next);
+                for (ProcessList::const_iterator m2 = next.begin(); m2 != next.end(); ++m2) {
+                    if (*m2 == home || *m2 == *m) {
+                        continue;
+                    }
+                    
+                    move[1] = Move(*q, *m2);
+                    const ProcessList& third = costs->getProcesses(*m2);
+                    for (ProcessList::const_iterator r = third.begin(); r != third.end(); ++r) {
+                        if (fixing->fixed[*r]) {
+                            continue;
+                        }
+                        move[2] = Move(*r, home);
+                        evaluate(move, 3);
+                    }
+                }
+            }
+        }
+    }
+    
+    last += width;
+    
+    #ifdef LOGGING
+    std::cerr << "{ExchangeSearch::runOnce} " << evaluations << " exchanges evaluated" << std::endl;
+    #endif
+    
+    if (best_move.empty()) {
+        return NULL;
+    }
+    
+    for (std::vector<Move>::const_iterator m = best_move.begin(); m != best_move.end(); ++m) {
+        trail.lift(m->first);
+    }
+    for (std::vector<Move>::const_iterator m = best_move.begin(); m != best_move.end(); ++m) {
+        trail.place(m->first, m->second);
+    }
+    
+    return trail.getResultState();
+}
@@ -0,0 +1,81 @@
+/*
+ * Authors: 
+ *   Felix Brandt <brandt@fzi.de>, 
+ *   Jochen Speck <speck@kit.edu>, 
+ *   Markus Voelker <markus.voelker@kit.edu>
+ *
+ * Copyright (c) 2012 Felix Brandt, Jochen Speck, Markus Voelker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining 
+ * a copy of this software and associated documentation files (the 
+ * "Software"), to deal in the Software without restriction, including 
+ * without limitation the rights to use, copy, modify, merge, publish, 
+ * distribute, sublicense, and/or sell copies of the Software, and to 
+ * permit persons to whom the Software is furnished to do so, subject to 
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included 
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#ifndef __ROADEF_EXCHANGESEARCH_H__
+#define __ROADEF_EXCHANGESEARCH_H__
+
+#include <vector>
+
+#include "IterativeSearch.h"
+#include "AssignmentTrail.h"
+
+/**
+ * Enumerate all moves, swaps and 3-rotations around the most expensive
+ * processes without a constraint model. The processes are taken from the
+ * worker's cost index, target machines are restricted to the precomputed
+ * cheapest fitting candidates per process. Each exchange is evaluated
+ * exactly on an AssignmentTrail and the best improving one is applied.
+ */
+class ExchangeSearch : public IterativeSearch
+{
+protected:
+    /** Process and target machine of one part of an exchange */
+    typedef std::pair<unsigned int, unsigned int> Move;
+    
+    /** Maximum number of processes per exchange (1 to 3) */
+    unsigned int size;
+    /** Number of candidate machines per process */
+    unsigned int targets;
+    /** Number of expensive processes swept per run */
+    unsigned int width;
+    /** Position in the cost ranking where the next sweep starts */
+    unsigned int last;
+    
+    AssignmentTrail trail;
+    
+    /** Best exchange found in this run and the resulting cost */
+    std::vector<Move> best_move;
+    long long best_cost;
+    unsigned long long evaluations;
+    
+    /** Processes ranked from @c last on with a positive reduction, at most @c width of them */
+    void getWindow (ProcessList& window) const;
+    /** Cheapest fitting target machines of a process other than its own */
+    void getCandidates (const ReAssignment& state, unsigned int process, ProcessList& machines);
+    /** Evaluate an exchange and keep it if it is the best so far */
+    void evaluate (const Move* move, unsigned int count);
+    
+public:
+    ExchangeSearch (int identifier, time_t start_time, unsigned int size = 3, unsigned int targets = 16, unsigned int width = 8);
+    virtual ~ExchangeSearch ();
+    
+    virtual ReAssignment* runOnce (const ReAssignment* state);
+};
+
+#endif /* __ROADEF_EXCHANGESEARCH_H__ */
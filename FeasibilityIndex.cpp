@@ -0,0 +1,160 @@
+/*
+ * Authors: 
+ *   Felix Brandt <brandt@fzi.de>, 
+ *   Jochen Speck <speck@kit.edu>, 
+ *   Markus Voelker <markus.voelker@kit.edu>
+ *
+ * Copyright (c) 2012 Felix Brandt, Jochen Speck, Markus Voelker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining 
+ * a copy of this software and associated documentation files (the 
+ * "Software"), to deal in the Software without restriction, including 
+ * without limitation the rights to use, copy, modify, merge, publish, 
+ * distribute, sublicense, and/or sell copies of the Software, and to 
+ * permit persons to whom the Software is furnished to do so, subject to 
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included 
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <algorithm>
+
+#include "FeasibilityIndex.h"
+
+FeasibilityIndex::FeasibilityIndex (unsigned int _levels) :
+instance(NULL), stamp(0), levels(_levels), words(0)
+{ }
+
+void FeasibilityIndex::setup (const ReAssignment& state)
+{
+    instance = state.instance;
+    words = (instance->num_machines + 63) / 64;
+    
+    threshold.assign(instance->num_resources, std::vector<int>());
+    offset.assign(instance->num_resources, 0);
+    
+    unsigned int total = 0;
+    for (unsigned int r = 0; r < (unsigned int)instance->num_resources; ++r) {
+        std::vector<int> values(1, 0);
+        for (unsigned int p = 0; p < (unsigned int)instance->num_processes; ++p) {
+            values.push_back(instance->process[p].requirement[r]);
+        }
+        std::sort(values.begin(), values.end());
+        values.erase(std::unique(values.begin(), values.end()), values.end());
+        
+        // quantiles of the distinct requirements, exact if there are only a few
+        std::vector<int>& t = threshold[r];
+        if (values.size() <= levels) {
+            t = values;
+        } else {
+            for (unsigned int l = 0; l < levels; ++l) {
+                t.push_back(values[(size_t)l * values.size() / levels]);
+            }
+        }
+        
+        offset[r] = total;
+        total += (unsigned int)t.size() * words;
+    }
+    
+    bits.assign(total, 0);
+    for (unsigned int m = 0; m < (unsigned int)instance->num_machines; ++m) {
+        setMachine(state, m);
+    }
+}
+
+void FeasibilityIndex::setMachine (const ReAssignment& state, unsigned int m)
+{
+    const Machine& machine = instance->machine[m];
+    unsigned int word = m / 64;
+    Word mask = (Word)1 << (m % 64);
+    
+    for (unsigned int r = 0; r < (unsigned int)instance->num_resources; ++r) {
+        int residual = machine.capacity[r] - machine.safety_capacity[r] - state.excess[m][r];
+        const std::vector<int>& t = threshold[r];
+        
+        for (unsigned int l = 0; l < t.size(); ++l) {
+            Word& w = bits[offset[r] + l * words + word];
+            if (residual >= t[l]) {
+                w |= mask;
+            } else {
+                w &= ~mask;
+            }
+        }
+    }
+}
+
+unsigned int FeasibilityIndex::getLevel (unsigned int r, int requirement) const
+{
+    const std::vector<int>& t = threshold[r];
+    return (unsigned int)(std::upper_bound(t.begin(), t.end(), requirement) - t.begin()) - 1;
+}
+
+void FeasibilityIndex::update (const ReAssignment& state)
+{
+    if (instance != state.instance) {
+        setup(state);
+    } else {
+        int first = state.findMoves(stamp);
+        if (first < 0) {
+            for (unsigned int m = 0; m < (unsigned int)instance->num_machines; ++m) {
+                setMachine(state, m);
+            }
+        } else {
+            for (unsigned int i = first; i < state.journal.size(); ++i) {
+                setMachine(state, state.journal[i].from);
+                setMachine(state, state.journal[i].to);
+            }
+        }
+    }
+    stamp = state.stamp;
+}
+
+void FeasibilityIndex::getMachines (const ReAssignment& state, unsigned int p, ProcessList& machines) const
+{
+    const Process& process = instance->process[p];
+    
+    std::vector<const Word*> row(instance->num_resources);
+    for (unsigned int r = 0; r < row.size(); ++r) {
+        row[r] = &(bits[offset[r] + getLevel(r, process.requirement[r]) * words]);
+    }
+    
+    machines.clear();
+    for (unsigned int w = 0; w < words; ++w) {
+        Word candidates = ~(Word)0;
+        for (unsigned int r = 0; r < row.size() && candidates; ++r) {
+            candidates &= row[r][w];
+        }
+        
+        // thresholds round down, so every candidate is checked exactly
+        while (candidates) {
+            unsigned int m = w * 64 + __builtin_ctzll(candidates);
+            candidates &= candidates - 1;
+            
+            if (m == state.assignment[p]) {
+                continue;
+            }
+            
+            const Machine& machine = instance->machine[m];
+            bool fits = true;
+            for (unsigned int r = 0; fits && r < (unsigned int)instance->num_resources; ++r) {
+                fits = state.excess[m][r] + process.requirement[r] <= machine.capacity[r] - machine.safety_capacity[r];
+                if (fits && r < instance->transient_count && process.original_machine != (int)m) {
+                    fits = state.transient[m][r] + process.requirement[r] <= machine.capacity[r];
+                }
+            }
+            
+            if (fits) {
+                machines.push_back(m);
+            }
+        }
+    }
+}
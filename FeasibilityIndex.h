@@ -0,0 +1,80 @@
+/*
+ * Authors: 
+ *   Felix Brandt <brandt@fzi.de>, 
+ *   Jochen Speck <speck@kit.edu>, 
+ *   Markus Voelker <markus.voelker@kit.edu>
+ *
+ * Copyright (c) 2012 Felix Brandt, Jochen Speck, Markus Voelker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining 
+ * a copy of this software and associated documentation files (the 
+ * "Software"), to deal in the Software without restriction, including 
+ * without limitation the rights to use, copy, modify, merge, publish, 
+ * distribute, sublicense, and/or sell copies of the Software, and to 
+ * permit persons to whom the Software is furnished to do so, subject to 
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included 
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#ifndef __ROADEF_FEASIBILITYINDEX_H__
+#define __ROADEF_FEASIBILITYINDEX_H__
+
+#include <vector>
+
+#include "Instance.h"
+
+/**
+ * Bit sets of the machines whose residual capacity reaches a threshold, for
+ * a few thresholds per resource. The machines a process may fit on are the
+ * AND of one bit set per resource, taken word by word; only these are
+ * checked exactly. Bits are only recomputed for the machines of the moves
+ * applied since the last update, as listed in the journal of the state.
+ */
+class FeasibilityIndex
+{
+protected:
+    typedef unsigned long long Word;
+    
+    const Instance* instance;
+    /** Stamp of the solution the bit sets are based on */
+    unsigned long long stamp;
+    
+    /** Maximum number of thresholds per resource */
+    unsigned int levels;
+    /** Number of words per bit set */
+    unsigned int words;
+    /** Ascending thresholds per resource, the first one is 0 */
+    std::vector<std::vector<int> > threshold;
+    /** First bit set of each resource in @c bits */
+    std::vector<unsigned int> offset;
+    /** Bit sets per resource and threshold */
+    std::vector<Word> bits;
+    
+    /** Choose the thresholds from the process requirements */
+    void setup (const ReAssignment& state);
+    /** Recompute the bits of a machine */
+    void setMachine (const ReAssignment& state, unsigned int machine);
+    /** Highest threshold not above the requirement */
+    unsigned int getLevel (unsigned int resource, int requirement) const;
+    
+public:
+    FeasibilityIndex (unsigned int levels = 64);
+    
+    /** Recompute the machines of the moves since the last update, all machines if the journal does not reach back */
+    void update (const ReAssignment& state);
+    /** Machines other than its own a process fits on, @c state has to be the one of the last update */
+    void getMachines (const ReAssignment& state, unsigned int process, ProcessList& machines) const;
+};
+
+#endif /* __ROADEF_FEASIBILITYINDEX_H__ */
@@ -0,0 +1,236 @@
+/*
+ * Authors: 
+ *   Felix Brandt <brandt@fzi.de>, 
+ *   Jochen Speck <speck@kit.edu>, 
+ *   Markus Voelker <markus.voelker@kit.edu>
+ *
+ * Copyright (c) 2012 Felix Brandt, Jochen Speck, Markus Voelker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining 
+ * a copy of this software and associated documentation files (the 
+ * "Software"), to deal in the Software without restriction, including 
+ * without limitation the rights to use, copy, modify, merge, publish, 
+ * distribute, sublicense, and/or sell copies of the Software, and to 
+ * permit persons to whom the Software is furnished to do so, subject to 
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included 
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "Incumbent.h"
+
+unsigned int Incumbent::log_size = 4096;
+
+Incumbent::Snapshot::Snapshot (const ReAssignment& _state) :
+state(_state), cost(_state.getCost()), version(0)
+{ }
+
+void Incumbent::Snapshot::follow (const Snapshot& previous)
+{
+    version = previous.version + 1;
+    log = previous.log;
+    
+    int position = state.findMoves(previous.state.stamp);
+    if (position >= 0) {
+        for (unsigned int i = position; i < state.journal.size(); ++i) {
+            const ReAssignment::Move& move = state.journal[i];
+            Change change = { version, move.process, move.to, move.cost };
+            log.push_back(change);
+        }
+    } else {
+        // not derived from the previous version, the last move carries the whole cost change
+        size_t start = log.size();
+        for (unsigned int p = 0; p < state.assignment.size(); ++p) {
+            if (state.assignment[p] != previous.state.assignment[p]) {
+                Change change = { version, p, state.assignment[p], 0 };
+                log.push_back(change);
+            }
+        }
+        if (log.size() > start) {
+            log.back().cost = cost - previous.cost;
+        }
+    }
+    
+    // drop the oldest versions as a whole
+    unsigned int first = 0;
+    while (log.size() - first > log_size) {
+        long long oldest = log[first].version;
+        while (first < log.size() && log[first].version == oldest) {
+            first++;
+        }
+    }
+    log.erase(log.begin(), log.begin() + first);
+}
+
+Incumbent::Incumbent (const ReAssignment& initial, int _readers) :
+current(new Snapshot(initial)), readers(_readers), retired(_readers)
+{
+    cost = current->cost;
+    hazard = new Snapshot* volatile[readers];
+    for (int i = 0; i < readers; ++i) {
+        hazard[i] = NULL;
+    }
+}
+
+Incumbent::~Incumbent ()
+{
+    for (int i = 0; i < readers; ++i) {
+        for (unsigned int j = 0; j < retired[i].size(); ++j) {
+            delete retired[i][j];
+        }
+    }
+    delete[] hazard;
+    delete current;
+}
+
+long long Incumbent::getCost () const
+{
+    return __sync_fetch_and_add(const_cast<volatile long long*>(&cost), 0);
+}
+
+Incumbent::Snapshot* Incumbent::load () const
+{
+    // a swap of NULL for NULL reads the pointer with a full barrier
+    return __sync_val_compare_and_swap(const_cast<Snapshot* volatile*>(&current), (Snapshot*)NULL, (Snapshot*)NULL);
+}
+
+void Incumbent::setHazard (int reader, Snapshot* snapshot)
+{
+    (void)__sync_lock_test_and_set(&hazard[reader], snapshot);
+    __sync_synchronize();
+}
+
+Incumbent::Snapshot* Incumbent::protect (int reader)
+{
+    Snapshot* snapshot;
+    do {
+        snapshot = load();
+        setHazard(reader, snapshot);
+    } while (snapshot != load());
+    return snapshot;
+}
+
+void Incumbent::retire (int reader, Snapshot* snapshot)
+{
+    std::vector<Snapshot*>& list = retired[reader];
+    list.push_back(snapshot);
+    
+    if ((int)list.size() < 2 * readers) {
+        return;
+    }
+    
+    unsigned int kept = 0;
+    for (unsigned int i = 0; i < list.size(); ++i) {
+        bool used = false;
+        for (int r = 0; r < readers && !used; ++r) {
+            used = (__sync_val_compare_and_swap(&hazard[r], (Snapshot*)NULL, (Snapshot*)NULL) == list[i]);
+        }
+        
+        if (used) {
+            list[kept++] = list[i];
+        } else {
+            delete list[i];
+        }
+    }
+    list.resize(kept);
+}
+
+ReAssignment* Incumbent::acquire (int reader, long long* version)
+{
+    Snapshot* snapshot = protect(reader);
+    ReAssignment* copy = new ReAssignment(snapshot->state);
+    if (version) {
+        *version = snapshot->version;
+    }
+    setHazard(reader, NULL);
+    return copy;
+}
+
+bool Incumbent::refresh (ReAssignment*& state, long long& version, int reader)
+{
+    Snapshot* snapshot = protect(reader);
+    
+    if (version == snapshot->version) {
+        setHazard(reader, NULL);
+        return false;
+    }
+    
+    // the log has to hold all versions after the given one, and their cost
+    // changes have to lead from the state to the snapshot
+    bool replayed = false;
+    const std::vector<Change>& log = snapshot->log;
+    if (version >= 0 && version < snapshot->version && !log.empty() && log.front().version <= version + 1) {
+        unsigned int first = 0;
+        while (first < log.size() && log[first].version <= version) {
+            first++;
+        }
+        
+        long long cost = state->getCost();
+        for (unsigned int i = first; i < log.size(); ++i) {
+            cost += log[i].cost;
+        }
+        
+        if (cost == snapshot->cost) {
+            for (unsigned int i = first; i < log.size(); ++i) {
+                state->move(log[i].process, log[i].machine);
+            }
+            replayed = true;
+        }
+    }
+    
+    if (!replayed) {
+        delete state;
+        state = new ReAssignment(snapshot->state);
+    }
+    
+    version = snapshot->version;
+    setHazard(reader, NULL);
+    return true;
+}
+
+bool Incumbent::publish (const ReAssignment& state, int reader, long long* version)
+{
+    if (state.getCost() >= getCost()) {
+        return false;
+    }
+    
+    // the copy is made before any shared data is touched
+    Snapshot* snapshot = new Snapshot(state);
+    
+    while (true) {
+        Snapshot* old = protect(reader);
+        
+        if (snapshot->cost >= old->cost) {
+            setHazard(reader, NULL);
+            delete snapshot;
+            return false;
+        }
+        
+        snapshot->follow(*old);
+        
+        if (__sync_bool_compare_and_swap(&current, old, snapshot)) {
+            setHazard(reader, NULL);
+            if (version) {
+                *version = snapshot->version;
+            }
+            
+            // costs only decrease, a concurrent publisher may have lowered it already
+            long long value = getCost();
+            while (snapshot->cost < value && !__sync_bool_compare_and_swap(&cost, value, snapshot->cost)) {
+                value = getCost();
+            }
+            
+            retire(reader, old);
+            return true;
+        }
+    }
+}
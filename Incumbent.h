@@ -0,0 +1,115 @@
+/*
+ * Authors: 
+ *   Felix Brandt <brandt@fzi.de>, 
+ *   Jochen Speck <speck@kit.edu>, 
+ *   Markus Voelker <markus.voelker@kit.edu>
+ *
+ * Copyright (c) 2012 Felix Brandt, Jochen Speck, Markus Voelker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining 
+ * a copy of this software and associated documentation files (the 
+ * "Software"), to deal in the Software without restriction, including 
+ * without limitation the rights to use, copy, modify, merge, publish, 
+ * distribute, sublicense, and/or sell copies of the Software, and to 
+ * permit persons to whom the Software is furnished to do so, subject to 
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included 
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#ifndef __ROADEF_INCUMBENT_H__
+#define __ROADEF_INCUMBENT_H__
+
+#include <vector>
+
+#include "ReAssignment.h"
+
+/**
+ * Best known solution shared by the worker threads. Each published solution
+ * is an immutable snapshot behind an atomically swapped pointer, its cost is
+ * kept in an atomic 64-bit value. Readers announce the snapshot they copy
+ * in a hazard slot, replaced snapshots are freed by their writer once no
+ * slot refers to them. Neither reading nor publishing takes a lock.
+ *
+ * Snapshots are numbered and carry a bounded log of the process moves of
+ * the latest versions and their cost changes, so a thread holding an older
+ * version can catch up by replaying the moves instead of copying the whole
+ * solution. The moves are taken from the journal of the published solution.
+ */
+class Incumbent
+{
+protected:
+    struct Change
+    {
+        long long version;
+        unsigned int process;
+        unsigned int machine;
+        /** Cost change, the moves of a version add up to its cost change */
+        long long cost;
+    };
+    
+    struct Snapshot
+    {
+        ReAssignment state;
+        long long cost;
+        long long version;
+        /** Moves leading to the latest versions, whole versions in increasing order */
+        std::vector<Change> log;
+        
+        Snapshot (const ReAssignment& state);
+        
+        /** Number this snapshot as the successor of another and log the moves between them, from the journal if it reaches back */
+        void follow (const Snapshot& previous);
+    };
+    
+    Snapshot* volatile current;
+    volatile long long cost;
+    
+    /** Number of reader slots, one per thread */
+    int readers;
+    /** Snapshot each reader is accessing */
+    Snapshot* volatile* hazard;
+    /** Snapshots replaced by each reader, not yet freed */
+    std::vector<std::vector<Snapshot*> > retired;
+    
+    /** Announce the snapshot a reader accesses, visible to all threads on return */
+    void setHazard (int reader, Snapshot* snapshot);
+    /** Current snapshot, unprotected */
+    Snapshot* load () const;
+    /** Current snapshot, protected by the reader's hazard slot until it is cleared */
+    Snapshot* protect (int reader);
+    /** Free the snapshot later when no reader accesses it anymore */
+    void retire (int reader, Snapshot* snapshot);
+    
+public:
+    Incumbent (const ReAssignment& initial, int readers);
+    ~Incumbent ();
+    
+    /** Cost of the current incumbent */
+    long long getCost () const;
+    /** Maximum number of logged moves */
+    static unsigned int log_size;
+    
+    /** Copy of the current incumbent, optionally with its version */
+    ReAssignment* acquire (int reader, long long* version = NULL);
+    /** Publish a solution if it is cheaper than the incumbent, true if it was; @c version receives its version */
+    bool publish (const ReAssignment& state, int reader, long long* version = NULL);
+    /**
+     * Bring a solution equal to the given version (-1 if unknown) up to the
+     * current incumbent, by replaying the logged moves or by copying it.
+     * Returns false if the solution is already up to date.
+     */
+    bool refresh (ReAssignment*& state, long long& version, int reader);
+};
+
+#endif /* __ROADEF_INCUMBENT_H__ */
@@ -1,57 +1,84 @@
-/*
- * Authors: 
- *   Felix Brandt <brandt@fzi.de>, 
- *   Jochen Speck <speck@kit.edu>, 
- *   Markus Voelker <markus.voelker@kit.edu>
- *
- * Copyright (c) 2012 Felix Brandt, Jochen Speck, Markus Voelker
- *
- * Permission is hereby granted, free of charge, to any person obtaining 
- * a copy of this software and associated documentation files (the 
- * "Software"), to deal in the Software without restriction, including 
- * without limitation the rights to use, copy, modify, merge, publish, 
- * distribute, sublicense, and/or sell copies of the Software, and to 
- * permit persons to whom the Software is furnished to do so, subject to 
- * the following conditions:
- *
- * The above copyright notice and this permission notice shall be included 
- * in all copies or substantial portions of the Software.
- *
- * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
- * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
- * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
- * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
- * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
- * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
- * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
- */
-
-#pragma once
-#ifndef __ROADEF_ITERATIVESEARCH_H__
-#define __ROADEF_ITERATIVESEARCH_H__
-
-#include "BaseSearch.h"
-
-/**
- * Base class for iterative search strategies.
- */
-class IterativeSearch : public BaseSearch
-{
-protected:
-    bool abort_on_nonimproving;
-    int identifier;
-    
-public:
-    /**
-     * Setup a local iterative search process
-     */
-    IterativeSearch(int identifier, time_t start_time, bool abort_on_nonimproving = true);
-    virtual ~IterativeSearch ();
-    
-    virtual ReAssignment* run(const ReAssignment* best_known, time_t time_limit);
-    virtual ReAssignment* runOnce(const ReAssignment* current_state) = 0;
-    
-    void process_cost(const ReAssignment& state, std::vector<ProcessCost>& cost);
-};
-
-#endif /* __ROADEF_ITERATIVESEARCH_H__ */
+/*
+ * Authors: 
+ *   Felix Brandt <brandt@fzi.de>, 
+ *   Jochen Speck <speck@kit.edu>, 
+ *   Markus Voelker <markus.voelker@kit.edu>
+ *
+ * Copyright (c) 2012 Felix Brandt, Jochen Speck, Markus Voelker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining 
+ * a copy of this software and associated documentation files (the 
+ * "Software"), to deal in the Software without restriction, including 
+ * without limitation the rights to use, copy, modify, merge, publish, 
+ * distribute, sublicense, and/or sell copies of the Software, and to 
+ * permit persons to whom the Software is furnished to do so, subject to 
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included 
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#ifndef __ROADEF_ITERATIVESEARCH_H__
+#define __ROADEF_ITERATIVESEARCH_H__
+
+#include "BaseSearch.h"
+#include "TrailSearch.h"
+#include "CandidateMachines.h"
+#include "FeasibilityIndex.h"
+#include "NeighborhoodController.h"
+
+/**
+ * Base class for iterative search strategies.
+ */
+class IterativeSearch : public BaseSearch
+{
+protected:
+    bool abort_on_nonimproving;
+    int identifier;
+    
+    /** Gecode free engine for small neighborhoods */
+    TrailSearch trail_search;
+    /** Cheapest target machines per process to restrict the domains */
+    CandidateMachines candidates;
+    /** Machines with enough residual capacity, machines without can't host a moved process during the search */
+    FeasibilityIndex feasibility;
+    /** Scaling of the neighborhood sizes and the fail budget of this strategy */
+    NeighborhoodController controller;
+    /** Machines the moved processes may be placed on, all machines if NULL */
+    const std::vector<bool>* allowed;
+    
+public:
+    /** Neighborhoods up to this size are searched by the trail engine instead of Gecode (0 disables) */
+    static unsigned int trail_threshold;
+    /** Number of candidate machines per moved process (0 for full domains) */
+    static unsigned int candidate_count;
+    
+    /**
+     * Setup a local iterative search process
+     */
+    IterativeSearch(int identifier, time_t start_time, bool abort_on_nonimproving = true);
+    virtual ~IterativeSearch ();
+    
+    virtual ReAssignment* run(const ReAssignment* best_known, const TimeBudget& budget);
+    virtual ReAssignment* runOnce(const ReAssignment* current_state) = 0;
+    
+    void process_cost(const ReAssignment& state, std::vector<ProcessCost>& cost);
+    
+    /**
+     * Search an improving reassignment of the moved processes, optionally with
+     * the process at @c fixed_index placed on @c machine. The engine is chosen
+     * by the neighborhood size.
+     */
+    ReAssignment* reschedule(const ReAssignment& state, const ProcessList& moved, int fixed_index = -1, int machine = -1);
+};
+
+#endif /* __ROADEF_ITERATIVESEARCH_H__ */
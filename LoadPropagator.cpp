@@ -0,0 +1,273 @@
+/*
+ * Authors: 
+ *   Felix Brandt <brandt@fzi.de>, 
+ *   Jochen Speck <speck@kit.edu>, 
+ *   Markus Voelker <markus.voelker@kit.edu>
+ *
+ * Copyright (c) 2012 Felix Brandt, Jochen Speck, Markus Voelker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining 
+ * a copy of this software and associated documentation files (the 
+ * "Software"), to deal in the Software without restriction, including 
+ * without limitation the rights to use, copy, modify, merge, publish, 
+ * distribute, sublicense, and/or sell copies of the Software, and to 
+ * permit persons to whom the Software is furnished to do so, subject to 
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included 
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include "LoadPropagator.h"
+
+using namespace Gecode;
+using namespace std;
+
+LoadPropagator::LoadPropagator (Home home, ViewArray<Int::IntView>& machine, ViewArray<Int::IntView>& cost) :
+Propagator(home),
+m_machine(machine), m_cost(cost),
+m_pending(machine.size())
+{
+    m_applied = static_cast<Space&>(home).alloc<bool>(m_machine.size());
+    for (int i = 0; i < m_machine.size(); ++i) {
+        m_applied[i] = false;
+    }
+    
+    m_machine.subscribe(home, *this, Int::PC_INT_DOM);
+    m_cost.subscribe(home, *this, Int::PC_INT_BND);
+}
+
+LoadPropagator::LoadPropagator (Home home, bool share, LoadPropagator& p) :
+Propagator(home, share, p),
+m_pending(p.m_pending)
+{
+    m_machine.update(home, share, p.m_machine);
+    m_cost.update(home, share, p.m_cost);
+    
+    m_applied = static_cast<Space&>(home).alloc<bool>(m_machine.size());
+    std::copy(p.m_applied, p.m_applied + m_machine.size(), m_applied);
+}
+
+LoadPropagator* LoadPropagator::copy (Space& home, bool share)
+{
+    return new (home) LoadPropagator(home, share, *this);
+}
+
+size_t LoadPropagator::dispose (Space& home)
+{
+    m_machine.cancel(home, *this, Int::PC_INT_DOM);
+    m_cost.cancel(home, *this, Int::PC_INT_BND);
+    
+    (void) Propagator::dispose(home);
+    
+    return sizeof(*this);
+}
+
+PropCost LoadPropagator::cost (const Space& home, const ModEventDelta& delta) const
+{
+    return PropCost::linear(PropCost::HI, m_pending);
+}
+
+ExecStatus LoadPropagator::propagate (Space& home, const ModEventDelta& delta)
+{
+    RescheduleSpace& space = static_cast<RescheduleSpace&>(home);
+    
+    // apply all processes assigned since the last run
+    for (int i = 0; i < m_machine.size(); ++i) {
+        if (m_applied[i] || !m_machine[i].assigned()) {
+            continue;
+        }
+        
+        long long cost = apply(space, i, m_machine[i].val());
+        
+        if (cost < 0) {
+            return ES_FAILED;
+        }
+        
+        #ifdef LOGGING
+        if (cost > Gecode::Int::Limits::max)
+            std::cerr << "{LoadPropagator::propagate} Warning: process cost exceeds 32bit integer" << std::endl;
+        #endif
+        
+        GECODE_ME_CHECK(m_cost[i].eq(home, (int)cost));
+        m_applied[i] = true;
+        m_pending--;
+    }
+    
+    if (m_pending == 0) {
+        return home.ES_SUBSUMED(*this);
+    }
+    
+    // update the bounds of the remaining processes against the new loads
+    for (int i = 0; i < m_machine.size(); ++i) {
+        if (!m_applied[i] && !m_machine[i].assigned()) {
+            GECODE_ES_CHECK(bound(space, i));
+        }
+    }
+    
+    return ES_NOFIX;
+}
+
+long long LoadPropagator::apply (RescheduleSpace& space, unsigned int index, unsigned int machine_id)
+{
+    const Process& process = space.instance.process[space.moved[index]];
+    MachinePatch patch(space.instance, MachinePatch::allocator_type(space));
+    
+    PatchMap::iterator it;
+    if (space.delta.end() != (it = space.delta.find(machine_id))) {
+        patch = it->second;
+    } else {
+        // initialize patch from the shared base or the original state
+        const int* excess;
+        const int* transient;
+        const int* balance;
+        space.getMachine(machine_id, excess, transient, balance);
+        std::copy(excess, excess + patch.excess.size(), patch.excess.begin());
+        std::copy(transient, transient + patch.transient.size(), patch.transient.begin());
+        std::copy(balance, balance + patch.balance.size(), patch.balance.begin());
+    }
+    
+    long long cost = applyLoad(space, process, machine_id, patch);
+    
+    if (cost < 0) {
+        return -1;
+    }
+    
+    cost += applyBalance(space, process, patch);
+    
+    if (process.original_machine != machine_id) {
+        cost += process.move_cost * space.instance.weight_process_move_cost;
+    }
+    
+    cost += space.instance.machine[process.original_machine].move_cost[machine_id] * space.instance.weight_machine_move_cost;
+    
+    if (space.delta.end() != it) {
+        it->second = patch;
+    } else {
+        space.delta.insert(PatchMap::value_type(machine_id, patch));
+    }
+    
+    return cost;
+}
+
+long long LoadPropagator::applyLoad (RescheduleSpace& space, const Process& process, unsigned int machine_id, MachinePatch& patch)
+{
+    // adjust excess load cost
+    const Instance& instance = space.instance;
+    const Machine& machine = instance.machine[machine_id];
+    
+    long long delta_load_cost = 0;
+    
+    for (unsigned int r = 0; r < process.requirement.size(); ++r) {
+        long long old_excess = std::max(0, patch.excess[r]);
+        patch.excess[r] += process.requirement[r];
+        long long new_excess = std::max(0, patch.excess[r]);
+        
+        if (patch.excess[r] > machine.capacity[r] - machine.safety_capacity[r]) {
+            return -1;
+        }
+        
+        if (r < instance.transient_count && process.original_machine != machine_id) {
+            patch.transient[r] += process.requirement[r];
+            if (patch.transient[r] > machine.capacity[r]) {
+                return -1;
+            }
+        }
+        
+        delta_load_cost += (new_excess - old_excess) * instance.resource[r].weight_load_cost;
+    }
+    
+    return delta_load_cost;
+}
+
+long long LoadPropagator::applyBalance (RescheduleSpace& space, const Process& process, MachinePatch& patch)
+{
+    // adjust balance cost
+    long long delta_balance_cost = 0;
+    
+    for (unsigned int b = 0; b < space.instance.balance.size(); ++b) {
+        const Balance& balance = space.instance.balance[b];
+        int process_balance = process.requirement[balance.resource2] - balance.balance * (process.requirement[balance.resource1]);
+        
+        if (process_balance < 0) {
+            space.min_unassigned_balance[b] -= process_balance;
+        } else { 
+            space.max_unassigned_balance[b] -= process_balance;
+        }
+        
+        long long old_balance = std::max(0, patch.balance[b]);
+        patch.balance[b] += process_balance;
+        long long new_balance = std::max(0, patch.balance[b]);
+        
+        delta_balance_cost += (new_balance - old_balance) * balance.weight_balance_cost;
+    }
+    
+    return delta_balance_cost;
+}
+
+ExecStatus LoadPropagator::bound (RescheduleSpace& space, unsigned int index)
+{
+    Int::IntView& machine = m_machine[index];
+    Int::IntView& cost = m_cost[index];
+    
+    ProcessList blacklist;
+    CostBound bound;
+    bound.min.cost = Gecode::Int::Limits::max;
+    bound.max.cost = Gecode::Int::Limits::min;
+    
+    for (Int::ViewValues<Int::IntView> m(machine); m(); ++m) {
+        // excess part is cached in the shared base for machines without changes
+        std::pair<int, int> c = space.getAdditionalCost(index, m.val());
+        
+        if (c.first == Gecode::Int::Limits::max || c.first > cost.max() || c.second < cost.min()) {
+            blacklist.push_back(m.val());
+        } else {
+            if (bound.min.cost > c.first) {
+                bound.min = BoundMachine(m.val(), c.first);
+            }
+            if (bound.max.cost < c.second) {
+                bound.max = BoundMachine(m.val(), c.second);
+            }
+        }
+    }
+    
+    space.cost_bound[index] = bound;
+    
+    for (ProcessList::const_iterator iter = blacklist.begin(); iter != blacklist.end(); ++iter) {
+        GECODE_ME_CHECK(machine.nq(space, (int)(*iter)));
+    }
+    
+    GECODE_ME_CHECK(cost.gq(space, (int)bound.min.cost));
+    GECODE_ME_CHECK(cost.lq(space, (int)bound.max.cost));
+    
+    return ES_OK;
+}
+
+ExecStatus LoadPropagator::post (Gecode::Home home)
+{
+    if (home.failed()) {
+        return ES_FAILED;
+    }
+    
+    RescheduleSpace& space = static_cast<RescheduleSpace&>((Space&)(home));
+    
+    ViewArray<Int::IntView> machine(space, space.process.size());
+    ViewArray<Int::IntView> cost(space, space.process_move_cost.size());
+    for (int i = 0; i < space.process.size(); ++i) {
+        machine[i] = Int::IntView(space.process[i]);
+        cost[i] = Int::IntView(space.process_move_cost[i]);
+    }
+    
+    new (home) LoadPropagator (home, machine, cost);
+    
+    return ES_OK;
+}
@@ -0,0 +1,81 @@
+/*
+ * Authors: 
+ *   Felix Brandt <brandt@fzi.de>, 
+ *   Jochen Speck <speck@kit.edu>, 
+ *   Markus Voelker <markus.voelker@kit.edu>
+ *
+ * Copyright (c) 2012 Felix Brandt, Jochen Speck, Markus Voelker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining 
+ * a copy of this software and associated documentation files (the 
+ * "Software"), to deal in the Software without restriction, including 
+ * without limitation the rights to use, copy, modify, merge, publish, 
+ * distribute, sublicense, and/or sell copies of the Software, and to 
+ * permit persons to whom the Software is furnished to do so, subject to 
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included 
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#pragma once
+#ifndef __ROADEF_LOADPROPAGATOR_H__
+#define __ROADEF_LOADPROPAGATOR_H__
+
+#include <gecode/int.hh>
+#include "Instance.h"
+#include "RescheduleSpace.h"
+
+/**
+ * Maintain the machine load of the whole neighborhood.
+ * Newly assigned processes are applied to the space delta in one batch,
+ * afterwards the cost bounds of all unassigned processes are updated in one pass.
+ */
+class LoadPropagator : public Gecode::Propagator
+{
+protected:
+    /** Machines the moved processes are assigned to */
+    Gecode::ViewArray<Gecode::Int::IntView> m_machine;
+    /** Cost of the moved processes */
+    Gecode::ViewArray<Gecode::Int::IntView> m_cost;
+    /** Flag per moved process whether its load is part of the space delta */
+    bool* m_applied;
+    /** Number of moved processes not yet applied */
+    int m_pending;
+    
+    /** Add the load of an assigned process to the space delta, returns its cost or -1 if it does not fit */
+    long long apply (RescheduleSpace& space, unsigned int index, unsigned int machine_id);
+    long long applyLoad (RescheduleSpace& space, const Process& process, unsigned int machine_id, MachinePatch& patch);
+    long long applyBalance (RescheduleSpace& space, const Process& process, MachinePatch& patch);
+    
+    /** Update cost bounds and remove machines that do not fit of an unassigned process */
+    Gecode::ExecStatus bound (RescheduleSpace& space, unsigned int index);
+    
+public:
+    /** Initializing constructor */
+    LoadPropagator (Gecode::Home home, Gecode::ViewArray<Gecode::Int::IntView>& machine, Gecode::ViewArray<Gecode::Int::IntView>& cost);
+    /** Copy constructor for Gecode search */
+    LoadPropagator (Gecode::Home home, bool share, LoadPropagator& p);
+    
+    /** Propagator copying for Gecode search */
+    virtual LoadPropagator* copy (Gecode::Space& home, bool share);
+    /** Propagator destruction for Gecode search */
+    virtual size_t dispose (Gecode::Space& home);
+    /** Linear in the number of moved processes */
+    virtual Gecode::PropCost cost (const Gecode::Space& home, const Gecode::ModEventDelta& delta) const;
+    /** Propagate */
+    virtual Gecode::ExecStatus propagate (Gecode::Space& home, const Gecode::ModEventDelta& delta);
+    /** Setup method for all moved processes of the space */
+    static Gecode::ExecStatus post (Gecode::Home home);
+};
+
+#endif /* __ROADEF_LOADPROPAGATOR_H__ */
@@ -0,0 +1,99 @@
+/*
+ * Authors: 
+ *   Felix Brandt <brandt@fzi.de>, 
+ *   Jochen Speck <speck@kit.edu>, 
+ *   Markus Voelker <markus.voelker@kit.edu>
+ *
+ * Copyright (c) 2012 Felix Brandt, Jochen Speck, Markus Voelker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining 
+ * a copy of this software and associated documentation files (the 
+ * "Software"), to deal in the Software without restriction, including 
+ * without limitation the rights to use, copy, modify, merge, publish, 
+ * distribute, sublicense, and/or sell copies of the Software, and to 
+ * permit persons to whom the Software is furnished to do so, subject to 
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included 
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <algorithm>
+
+#include "MachineRegions.h"
+
+MachineRegions::MachineRegions (unsigned int _count) :
+instance(NULL), count(std::max(1u, _count)), round(-1)
+{ }
+
+unsigned long long MachineRegions::mix (unsigned long long key, unsigned long long round)
+{
+    // splitmix64 finalizer
+    unsigned long long z = key * 0x9E3779B97F4A7C15ULL + round + 1;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+void MachineRegions::update (const Instance& _instance, long long _round)
+{
+    if (instance == &_instance && round == _round)
+        return;
+    instance = &_instance;
+    round = _round;
+    
+    // groups of machines kept in one region: neighborhoods, or single machines if there are too few
+    std::vector<ProcessList> groups;
+    if (instance->neighborhood.size() >= 2 * count) {
+        groups = instance->neighborhood;
+    } else {
+        groups.resize(instance->num_machines);
+        for (unsigned int m = 0; m < groups.size(); ++m)
+            groups[m].push_back(m);
+    }
+    
+    std::vector<std::pair<unsigned long long, unsigned int> > order(groups.size());
+    for (unsigned int g = 0; g < groups.size(); ++g)
+        order[g] = std::make_pair(mix(g, round), g);
+    std::sort(order.begin(), order.end());
+    
+    // cut the shuffled groups into chunks of about the same number of machines
+    region.assign(instance->num_machines, 0);
+    machines.assign(count, ProcessList());
+    mask.assign(count, std::vector<bool>(instance->num_machines, false));
+    
+    unsigned int seen = 0;
+    for (unsigned int i = 0; i < order.size(); ++i) {
+        const ProcessList& group = groups[order[i].second];
+        unsigned int r = std::min(count - 1, (unsigned int)((unsigned long long)seen * count / instance->num_machines));
+        for (unsigned int j = 0; j < group.size(); ++j) {
+            region[group[j]] = r;
+            machines[r].push_back(group[j]);
+            mask[r][group[j]] = true;
+        }
+        seen += group.size();
+    }
+}
+
+unsigned int MachineRegions::getRegion (unsigned int m) const
+{
+    return region[m];
+}
+
+const ProcessList& MachineRegions::getMachines (unsigned int r) const
+{
+    return machines[r];
+}
+
+const std::vector<bool>& MachineRegions::getMask (unsigned int r) const
+{
+    return mask[r];
+}
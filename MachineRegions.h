@@ -0,0 +1,73 @@
+/*
+ * Authors: 
+ *   Felix Brandt <brandt@fzi.de>, 
+ *   Jochen Speck <speck@kit.edu>, 
+ *   Markus Voelker <markus.voelker@kit.edu>
+ *
+ * Copyright (c) 2012 Felix Brandt, Jochen Speck, Markus Voelker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining 
+ * a copy of this software and associated documentation files (the 
+ * "Software"), to deal in the Software without restriction, including 
+ * without limitation the rights to use, copy, modify, merge, publish, 
+ * distribute, sublicense, and/or sell copies of the Software, and to 
+ * permit persons to whom the Software is furnished to do so, subject to 
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included 
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#ifndef __ROADEF_MACHINEREGIONS_H__
+#define __ROADEF_MACHINEREGIONS_H__
+
+#include <vector>
+
+#include "Instance.h"
+
+/**
+ * Partition of the machines into disjoint regions of similar size, one per
+ * worker. Whole neighborhoods are kept together if there are enough of them.
+ * The partition only depends on the instance and the round, so all workers
+ * agree on it without communication, and it is reshuffled every round so
+ * that moves between former regions get explored as well.
+ */
+class MachineRegions
+{
+protected:
+    const Instance* instance;
+    unsigned int count;
+    long long round;
+    
+    /** Region of each machine */
+    std::vector<unsigned int> region;
+    /** Machines of each region */
+    std::vector<ProcessList> machines;
+    /** Membership of each machine in each region */
+    std::vector<std::vector<bool> > mask;
+    
+    /** Pseudo random but reproducible order of the machine groups in a round */
+    static unsigned long long mix (unsigned long long key, unsigned long long round);
+    
+public:
+    MachineRegions (unsigned int count);
+    
+    /** Partition the machines for the given round, nothing is done if it is the current one */
+    void update (const Instance& instance, long long round);
+    
+    unsigned int getCount () const { return count; }
+    unsigned int getRegion (unsigned int machine) const;
+    const ProcessList& getMachines (unsigned int region) const;
+    const std::vector<bool>& getMask (unsigned int region) const;
+};
+
+#endif /* __ROADEF_MACHINEREGIONS_H__ */
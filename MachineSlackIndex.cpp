@@ -0,0 +1,118 @@
+/*
+ * Authors: 
+ *   Felix Brandt <brandt@fzi.de>, 
+ *   Jochen Speck <speck@kit.edu>, 
+ *   Markus Voelker <markus.voelker@kit.edu>
+ *
+ * Copyright (c) 2012 Felix Brandt, Jochen Speck, Markus Voelker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining 
+ * a copy of this software and associated documentation files (the 
+ * "Software"), to deal in the Software without restriction, including 
+ * without limitation the rights to use, copy, modify, merge, publish, 
+ * distribute, sublicense, and/or sell copies of the Software, and to 
+ * permit persons to whom the Software is furnished to do so, subject to 
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included 
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "MachineSlackIndex.h"
+
+MachineSlackIndex::MachineSlackIndex () :
+instance(NULL), stamp(0)
+{ }
+
+void MachineSlackIndex::setMachine (const ReAssignment& state, unsigned int m)
+{
+    long long total = 0;
+    for (unsigned int r = 0; r < (unsigned int)instance->num_resources; ++r) {
+        total += state.excess[m][r];
+    }
+    
+    if (total != key[m]) {
+        order.erase(std::make_pair(key[m], (int)m));
+        key[m] = total;
+        order.insert(std::make_pair(key[m], (int)m));
+    }
+}
+
+void MachineSlackIndex::update (const ReAssignment& state)
+{
+    if (instance != state.instance) {
+        instance = state.instance;
+        key.assign(instance->num_machines, 0);
+        order.clear();
+        
+        for (unsigned int m = 0; m < (unsigned int)instance->num_machines; ++m) {
+            order.insert(std::make_pair(0LL, (int)m));
+            setMachine(state, m);
+        }
+    } else {
+        int first = state.findMoves(stamp);
+        if (first < 0) {
+            for (unsigned int m = 0; m < (unsigned int)instance->num_machines; ++m) {
+                setMachine(state, m);
+            }
+        } else {
+            for (unsigned int i = first; i < state.journal.size(); ++i) {
+                setMachine(state, state.journal[i].from);
+                setMachine(state, state.journal[i].to);
+            }
+        }
+    }
+    stamp = state.stamp;
+}
+
+MachineSlackIndex::Cursor::Cursor (const MachineSlackIndex& _index, const ReAssignment& _state, unsigned int _process) :
+index(&_index), state(&_state), process(_process), demand(0), it(_index.order.begin())
+{
+    const Process& p = state->instance->process[process];
+    for (unsigned int r = 0; r < (unsigned int)state->instance->num_resources; ++r) {
+        demand += p.requirement[r];
+    }
+}
+
+bool MachineSlackIndex::Cursor::next (ProcessCost& machine)
+{
+    const Instance& instance = *state->instance;
+    const Process& p = instance.process[process];
+    
+    // score machines until no unscored one can be cheaper than the best scored one
+    while (it != index->order.end() && (pending.empty() || pending.top().cost > it->first + demand)) {
+        int m = it->second;
+        ++it;
+        
+        bool valid = true;
+        long long cost = 0;
+        for (unsigned int r = 0; r < (unsigned int)instance.num_resources; ++r) {
+            if (instance.machine[m].capacity[r] < p.requirement[r]) {
+                valid = false;
+                break;
+            }
+            int cc = state->excess[m][r] + p.requirement[r];
+            cost += (cc > 0 ? 2 : 1) * cc;
+        }
+        
+        if (valid) {
+            pending.push(ProcessCost(m, cost));
+        }
+    }
+    
+    if (pending.empty()) {
+        return false;
+    }
+    
+    machine = pending.top();
+    pending.pop();
+    return true;
+}
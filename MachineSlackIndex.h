@@ -0,0 +1,90 @@
+/*
+ * Authors: 
+ *   Felix Brandt <brandt@fzi.de>, 
+ *   Jochen Speck <speck@kit.edu>, 
+ *   Markus Voelker <markus.voelker@kit.edu>
+ *
+ * Copyright (c) 2012 Felix Brandt, Jochen Speck, Markus Voelker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining 
+ * a copy of this software and associated documentation files (the 
+ * "Software"), to deal in the Software without restriction, including 
+ * without limitation the rights to use, copy, modify, merge, publish, 
+ * distribute, sublicense, and/or sell copies of the Software, and to 
+ * permit persons to whom the Software is furnished to do so, subject to 
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included 
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#ifndef __ROADEF_MACHINESLACKINDEX_H__
+#define __ROADEF_MACHINESLACKINDEX_H__
+
+#include <set>
+#include <queue>
+#include <vector>
+
+#include "Instance.h"
+
+/**
+ * Machines ordered by their total excess over the safety capacities. The
+ * order is updated for the machines of the moves applied since the last
+ * update, so the cheapest targets of a process can be enumerated without
+ * scoring all machines.
+ */
+class MachineSlackIndex
+{
+protected:
+    typedef std::set<std::pair<long long, int> > Order;
+    
+    const Instance* instance;
+    /** Stamp of the solution the order is based on */
+    unsigned long long stamp;
+    /** Total excess per machine */
+    std::vector<long long> key;
+    Order order;
+    
+    void setMachine (const ReAssignment& state, unsigned int machine);
+    
+public:
+    /**
+     * Enumerates the machines able to hold a process by increasing target
+     * cost, i.e. the sum of the excesses after adding the process, positive
+     * ones counted twice. The total excess plus the process demand is a lower
+     * bound of this cost, so machines are scored lazily along the order.
+     */
+    class Cursor
+    {
+    protected:
+        const MachineSlackIndex* index;
+        const ReAssignment* state;
+        unsigned int process;
+        long long demand;
+        Order::const_iterator it;
+        /** Scored machines not yet returned, cheapest on top */
+        std::priority_queue<ProcessCost> pending;
+        
+    public:
+        Cursor (const MachineSlackIndex& index, const ReAssignment& state, unsigned int process);
+        
+        /** Next machine and its target cost, false when all machines have been returned */
+        bool next (ProcessCost& machine);
+    };
+    
+    MachineSlackIndex ();
+    
+    /** Reorder the machines of the moves since the last update, all machines if the journal does not reach back */
+    void update (const ReAssignment& state);
+};
+
+#endif /* __ROADEF_MACHINESLACKINDEX_H__ */
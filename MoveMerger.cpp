@@ -0,0 +1,88 @@
+/*
+ * Authors: 
+ *   Felix Brandt <brandt@fzi.de>, 
+ *   Jochen Speck <speck@kit.edu>, 
+ *   Markus Voelker <markus.voelker@kit.edu>
+ *
+ * Copyright (c) 2012 Felix Brandt, Jochen Speck, Markus Voelker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining 
+ * a copy of this software and associated documentation files (the 
+ * "Software"), to deal in the Software without restriction, including 
+ * without limitation the rights to use, copy, modify, merge, publish, 
+ * distribute, sublicense, and/or sell copies of the Software, and to 
+ * permit persons to whom the Software is furnished to do so, subject to 
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included 
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "MoveMerger.h"
+
+MoveMerger::MoveMerger ()
+{ }
+
+bool MoveMerger::apply (unsigned int p, unsigned int m)
+{
+    if (trail.getMachine(p) == (int)m) {
+        return false;
+    }
+    
+    long long cost = trail.getCost();
+    size_t mark = trail.mark();
+    
+    trail.lift(p);
+    if (trail.fits(p, m) && !trail.conflicts(p, m)) {
+        trail.place(p, m);
+        if (trail.getCost() < cost && trail.valid()) {
+            return true;
+        }
+    }
+    
+    trail.undo(mark);
+    return false;
+}
+
+ReAssignment* MoveMerger::merge (const ReAssignment& base, const ReAssignment& improved, const ReAssignment& target)
+{
+    ProcessList moved;
+    for (unsigned int p = 0; p < improved.assignment.size(); ++p) {
+        if (improved.assignment[p] != base.assignment[p]) {
+            moved.push_back(p);
+        }
+    }
+    
+    trail.reset(target);
+    long long initial_cost = trail.getCost();
+    
+    // moves of one improvement often depend on each other, so rejected moves
+    // are retried as long as some move is accepted
+    bool changed = true;
+    while (changed && !moved.empty()) {
+        changed = false;
+        unsigned int kept = 0;
+        
+        for (unsigned int i = 0; i < moved.size(); ++i) {
+            if (apply(moved[i], improved.assignment[moved[i]])) {
+                changed = true;
+            } else if (trail.getMachine(moved[i]) != (int)improved.assignment[moved[i]]) {
+                moved[kept++] = moved[i];
+            }
+        }
+        moved.resize(kept);
+    }
+    
+    if (trail.getCost() >= initial_cost) {
+        return NULL;
+    }
+    return trail.getResultState();
+}
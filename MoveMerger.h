@@ -0,0 +1,59 @@
+/*
+ * Authors: 
+ *   Felix Brandt <brandt@fzi.de>, 
+ *   Jochen Speck <speck@kit.edu>, 
+ *   Markus Voelker <markus.voelker@kit.edu>
+ *
+ * Copyright (c) 2012 Felix Brandt, Jochen Speck, Markus Voelker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining 
+ * a copy of this software and associated documentation files (the 
+ * "Software"), to deal in the Software without restriction, including 
+ * without limitation the rights to use, copy, modify, merge, publish, 
+ * distribute, sublicense, and/or sell copies of the Software, and to 
+ * permit persons to whom the Software is furnished to do so, subject to 
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included 
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#ifndef __ROADEF_MOVEMERGER_H__
+#define __ROADEF_MOVEMERGER_H__
+
+#include "AssignmentTrail.h"
+
+/**
+ * Transfer an improvement found on an outdated solution to a newer one.
+ * The moves leading from the old base to the improvement are replayed on
+ * the newer solution one by one, each is kept if it is feasible there and
+ * lowers the cost.
+ */
+class MoveMerger
+{
+protected:
+    AssignmentTrail trail;
+    
+    /** Replay a move, keep it if it is feasible and improving */
+    bool apply (unsigned int process, unsigned int machine);
+    
+public:
+    MoveMerger ();
+    
+    /**
+     * Replay the moves from @c base to @c improved on @c target. Returns
+     * the merged solution if it is cheaper than @c target, NULL otherwise.
+     */
+    ReAssignment* merge (const ReAssignment& base, const ReAssignment& improved, const ReAssignment& target);
+};
+
+#endif /* __ROADEF_MOVEMERGER_H__ */
@@ -0,0 +1,96 @@
+/*
+ * Authors: 
+ *   Felix Brandt <brandt@fzi.de>, 
+ *   Jochen Speck <speck@kit.edu>, 
+ *   Markus Voelker <markus.voelker@kit.edu>
+ *
+ * Copyright (c) 2012 Felix Brandt, Jochen Speck, Markus Voelker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining 
+ * a copy of this software and associated documentation files (the 
+ * "Software"), to deal in the Software without restriction, including 
+ * without limitation the rights to use, copy, modify, merge, publish, 
+ * distribute, sublicense, and/or sell copies of the Software, and to 
+ * permit persons to whom the Software is furnished to do so, subject to 
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included 
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "MovedProcessIndex.h"
+
+MovedProcessIndex::MovedProcessIndex () :
+instance(NULL), stamp(0)
+{ }
+
+void MovedProcessIndex::insert (ProcessList& list, std::vector<unsigned int>& slot, unsigned int p)
+{
+    slot[p] = list.size();
+    list.push_back(p);
+}
+
+void MovedProcessIndex::erase (ProcessList& list, std::vector<unsigned int>& slot, unsigned int p)
+{
+    list[slot[p]] = list.back();
+    slot[list.back()] = slot[p];
+    list.pop_back();
+}
+
+void MovedProcessIndex::add (unsigned int p, unsigned int m)
+{
+    if ((int)m != instance->process[p].original_machine) {
+        insert(moved, moved_slot, p);
+        insert(current[m], current_slot, p);
+    }
+}
+
+void MovedProcessIndex::remove (unsigned int p, unsigned int m)
+{
+    if ((int)m != instance->process[p].original_machine) {
+        erase(moved, moved_slot, p);
+        erase(current[m], current_slot, p);
+    }
+}
+
+void MovedProcessIndex::update (const ReAssignment& state)
+{
+    int first = (instance == state.instance) ? state.findMoves(stamp) : -1;
+    
+    if (first < 0) {
+        instance = state.instance;
+        
+        moved.clear();
+        current.assign(instance->num_machines, ProcessList());
+        moved_slot.assign(instance->num_processes, 0);
+        current_slot.assign(instance->num_processes, 0);
+        
+        for (unsigned int p = 0; p < state.assignment.size(); ++p) {
+            add(p, state.assignment[p]);
+        }
+    } else {
+        for (unsigned int i = first; i < state.journal.size(); ++i) {
+            remove(state.journal[i].process, state.journal[i].from);
+            add(state.journal[i].process, state.journal[i].to);
+        }
+    }
+    stamp = state.stamp;
+}
+
+const ProcessList& MovedProcessIndex::getMoved () const
+{
+    return moved;
+}
+
+const ProcessList& MovedProcessIndex::getMovedTo (unsigned int m) const
+{
+    return current[m];
+}
@@ -0,0 +1,73 @@
+/*
+ * Authors: 
+ *   Felix Brandt <brandt@fzi.de>, 
+ *   Jochen Speck <speck@kit.edu>, 
+ *   Markus Voelker <markus.voelker@kit.edu>
+ *
+ * Copyright (c) 2012 Felix Brandt, Jochen Speck, Markus Voelker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining 
+ * a copy of this software and associated documentation files (the 
+ * "Software"), to deal in the Software without restriction, including 
+ * without limitation the rights to use, copy, modify, merge, publish, 
+ * distribute, sublicense, and/or sell copies of the Software, and to 
+ * permit persons to whom the Software is furnished to do so, subject to 
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included 
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#ifndef __ROADEF_MOVEDPROCESSINDEX_H__
+#define __ROADEF_MOVEDPROCESSINDEX_H__
+
+#include <vector>
+
+#include "Instance.h"
+
+/**
+ * Processes not on their original machine, all of them and grouped by their
+ * current machine. Only the processes of the moves applied since the last
+ * update are touched, the moves are taken from the journal of the state.
+ */
+class MovedProcessIndex
+{
+protected:
+    const Instance* instance;
+    /** Stamp of the solution the lists are based on */
+    unsigned long long stamp;
+    
+    ProcessList moved;
+    std::vector<ProcessList> current;
+    /** Position of each moved process in the lists above */
+    std::vector<unsigned int> moved_slot;
+    std::vector<unsigned int> current_slot;
+    
+    static void insert (ProcessList& list, std::vector<unsigned int>& slot, unsigned int process);
+    static void erase (ProcessList& list, std::vector<unsigned int>& slot, unsigned int process);
+    
+    void add (unsigned int process, unsigned int machine);
+    void remove (unsigned int process, unsigned int machine);
+    
+public:
+    MovedProcessIndex ();
+    
+    /** Update the lists for the moves since the last update, rebuild them if the journal does not reach back */
+    void update (const ReAssignment& state);
+    
+    /** All moved processes */
+    const ProcessList& getMoved () const;
+    /** Moved processes currently on a machine */
+    const ProcessList& getMovedTo (unsigned int machine) const;
+};
+
+#endif /* __ROADEF_MOVEDPROCESSINDEX_H__ */
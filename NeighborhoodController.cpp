@@ -0,0 +1,91 @@
+/*
+ * Authors: 
+ *   Felix Brandt <brandt@fzi.de>, 
+ *   Jochen Speck <speck@kit.edu>, 
+ *   Markus Voelker <markus.voelker@kit.edu>
+ *
+ * Copyright (c) 2012 Felix Brandt, Jochen Speck, Markus Voelker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining 
+ * a copy of this software and associated documentation files (the 
+ * "Software"), to deal in the Software without restriction, including 
+ * without limitation the rights to use, copy, modify, merge, publish, 
+ * distribute, sublicense, and/or sell copies of the Software, and to 
+ * permit persons to whom the Software is furnished to do so, subject to 
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included 
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <algorithm>
+#include <iostream>
+
+#include "NeighborhoodController.h"
+#include "AdaptiveScheduler.h"
+
+double NeighborhoodController::target_success = 0;
+double NeighborhoodController::target_time = 0.05;
+unsigned int NeighborhoodController::window = 20;
+
+NeighborhoodController::NeighborhoodController (int _identifier) :
+identifier(_identifier), factor(1), runs(0), successes(0), stops(0), cpu_time(0), started(0)
+{ }
+
+int NeighborhoodController::scale (int size) const
+{
+    return std::max(1, (int)(size * factor + 0.5));
+}
+
+unsigned int NeighborhoodController::getFailLimit (unsigned int size) const
+{
+    return std::max(1u, (unsigned int)(size * 5 * factor + 0.5));
+}
+
+void NeighborhoodController::start ()
+{
+    if (target_success > 0) {
+        started = AdaptiveScheduler::getThreadTime();
+    }
+}
+
+void NeighborhoodController::stop (bool success, bool stopped)
+{
+    if (target_success <= 0) {
+        return;
+    }
+    
+    runs++;
+    successes += success;
+    stops += stopped;
+    cpu_time += AdaptiveScheduler::getThreadTime() - started;
+    
+    if (runs < window) {
+        return;
+    }
+    
+    double rate = (double)successes / runs;
+    double time = cpu_time / runs;
+    
+    if (time > target_time || rate > 2 * target_success) {
+        // searches time out or are too easy
+        factor = std::max(0.5, factor / 1.1);
+    } else if (rate < target_success) {
+        factor = std::min(3.0, factor * 1.1);
+    }
+    
+    #ifdef LOGGING
+    std::cerr << identifier << " controller: rate " << rate << " stopped " << (double)stops / runs << " time " << time << " factor " << factor << std::endl;
+    #endif
+    
+    runs = successes = stops = 0;
+    cpu_time = 0;
+}
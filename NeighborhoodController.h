@@ -0,0 +1,74 @@
+/*
+ * Authors: 
+ *   Felix Brandt <brandt@fzi.de>, 
+ *   Jochen Speck <speck@kit.edu>, 
+ *   Markus Voelker <markus.voelker@kit.edu>
+ *
+ * Copyright (c) 2012 Felix Brandt, Jochen Speck, Markus Voelker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining 
+ * a copy of this software and associated documentation files (the 
+ * "Software"), to deal in the Software without restriction, including 
+ * without limitation the rights to use, copy, modify, merge, publish, 
+ * distribute, sublicense, and/or sell copies of the Software, and to 
+ * permit persons to whom the Software is furnished to do so, subject to 
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included 
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#ifndef __ROADEF_NEIGHBORHOODCONTROLLER_H__
+#define __ROADEF_NEIGHBORHOODCONTROLLER_H__
+
+/**
+ * Feedback control of the neighborhood size and the fail budget of one
+ * search strategy. After each window of reschedules both are scaled up if
+ * the success rate fell below the target and scaled down if the searches
+ * took too long or succeeded far more often than targeted.
+ */
+class NeighborhoodController
+{
+protected:
+    int identifier;
+    /** Factor applied to the neighborhood sizes and the fail budget */
+    double factor;
+    
+    unsigned int runs;
+    unsigned int successes;
+    unsigned int stops;
+    double cpu_time;
+    /** Thread CPU time at the start of the current search */
+    double started;
+    
+public:
+    /** Aimed share of improving reschedules (0 disables the controller) */
+    static double target_success;
+    /** Aimed CPU seconds per reschedule */
+    static double target_time;
+    /** Number of reschedules between adjustments */
+    static unsigned int window;
+    
+    NeighborhoodController (int identifier);
+    
+    /** Scale a neighborhood size, the result is at least 1 */
+    int scale (int size) const;
+    /** Fail limit for a neighborhood of the given number of processes */
+    unsigned int getFailLimit (unsigned int size) const;
+    
+    /** Mark the start of a search */
+    void start ();
+    /** Record the outcome of the search started last */
+    void stop (bool success, bool stopped);
+};
+
+#endif /* __ROADEF_NEIGHBORHOODCONTROLLER_H__ */
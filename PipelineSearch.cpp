@@ -0,0 +1,195 @@
+/*
+ * Authors: 
+ *   Felix Brandt <brandt@fzi.de>, 
+ *   Jochen Speck <speck@kit.edu>, 
+ *   Markus Voelker <markus.voelker@kit.edu>
+ *
+ * Copyright (c) 2012 Felix Brandt, Jochen Speck, Markus Voelker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining 
+ * a copy of this software and associated documentation files (the 
+ * "Software"), to deal in the Software without restriction, including 
+ * without limitation the rights to use, copy, modify, merge, publish, 
+ * distribute, sublicense, and/or sell copies of the Software, and to 
+ * permit persons to whom the Software is furnished to do so, subject to 
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included 
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <pthread.h>
+
+#include "PipelineSearch.h"
+#include "AdaptiveScheduler.h"
+
+PipelineSearch::PipelineSearch (int _identifier, time_t _start_time, unsigned int helpers, unsigned int _batch, unsigned int _size) :
+BaseSearch(_start_time), identifier(_identifier), size(_size), batch(_batch), snapshot(NULL), next_job(0), helper_time(0)
+{
+    for (unsigned int i = 0; i < helpers; ++i) {
+        solvers.push_back(new RandomSearch(identifier, _start_time, _size));
+    }
+}
+
+PipelineSearch::~PipelineSearch ()
+{
+    for (unsigned int i = 0; i < solvers.size(); ++i) {
+        delete solvers[i];
+    }
+}
+
+void* PipelineSearch::work (void* data)
+{
+    Helper& helper = *(Helper*)data;
+    PipelineSearch& search = *helper.search;
+    RandomSearch& solver = *search.solvers[helper.index];
+    
+    double cpu_time = AdaptiveScheduler::getThreadTime();
+    
+    while (!search.expired() && !search.interrupted()) {
+        unsigned int j = __sync_fetch_and_add(&search.next_job, 1);
+        if (j >= search.jobs.size()) {
+            break;
+        }
+        
+        Job& job = search.jobs[j];
+        job.result = solver.reschedule(*search.snapshot, job.processes);
+    }
+    
+    helper.cpu_time = AdaptiveScheduler::getThreadTime() - cpu_time;
+    return NULL;
+}
+
+bool PipelineSearch::commit (ReAssignment& state, const Job& job, std::vector<bool>& machines, std::vector<bool>& services, std::vector<bool>& processes)
+{
+    const Instance& instance = *state.instance;
+    const ReAssignment& result = *job.result;
+    
+    // moved processes and the machines and services whose constraints and costs the result relies on
+    ProcessList changed;
+    std::vector<unsigned int> touched_machines;
+    std::vector<unsigned int> touched_services;
+    
+    for (unsigned int i = 0; i < job.processes.size(); ++i) {
+        unsigned int p = job.processes[i];
+        // the result expects the process where the snapshot has it
+        if (processes[p]) {
+            return false;
+        }
+        if (result.assignment[p] == snapshot->assignment[p]) {
+            continue;
+        }
+        
+        changed.push_back(p);
+        touched_machines.push_back(snapshot->assignment[p]);
+        touched_machines.push_back(result.assignment[p]);
+        
+        const Service& service = instance.service[instance.process[p].service];
+        touched_services.push_back(instance.process[p].service);
+        touched_services.insert(touched_services.end(), service.depends_on.begin(), service.depends_on.end());
+        touched_services.insert(touched_services.end(), service.required_by.begin(), service.required_by.end());
+    }
+    
+    for (unsigned int i = 0; i < touched_machines.size(); ++i) {
+        if (machines[touched_machines[i]]) {
+            return false;
+        }
+    }
+    for (unsigned int i = 0; i < touched_services.size(); ++i) {
+        if (services[touched_services[i]]) {
+            return false;
+        }
+    }
+    
+    for (unsigned int i = 0; i < changed.size(); ++i) {
+        state.move(changed[i], result.assignment[changed[i]]);
+        processes[changed[i]] = true;
+    }
+    for (unsigned int i = 0; i < touched_machines.size(); ++i) {
+        machines[touched_machines[i]] = true;
+    }
+    for (unsigned int i = 0; i < touched_services.size(); ++i) {
+        services[touched_services[i]] = true;
+    }
+    return true;
+}
+
+ReAssignment* PipelineSearch::run (const ReAssignment* best_known, const TimeBudget& _budget)
+{
+    budget = _budget;
+    for (unsigned int i = 0; i < solvers.size(); ++i) {
+        solvers[i]->setBudget(budget);
+    }
+    base_cost = best_known->getCost();
+    
+    const Instance& instance = *best_known->instance;
+    ReAssignment* state = new ReAssignment(*best_known);
+    unsigned int stale = 0;
+    
+    std::vector<pthread_t> threads(solvers.size());
+    std::vector<Helper> helpers(solvers.size());
+    helper_time = 0;
+    
+    while (stale < 50 && !expired() && !interrupted()) {
+        // produce a batch of neighborhoods against the current solution
+        ReAssignment current(*state);
+        snapshot = &current;
+        costs->update(current, *fixing);
+        
+        jobs.resize(batch);
+        for (unsigned int j = 0; j < batch; ++j) {
+            costs->sample(size, jobs[j].processes, random);
+            jobs[j].result = NULL;
+        }
+        next_job = 0;
+        
+        for (unsigned int i = 0; i < helpers.size(); ++i) {
+            helpers[i].search = this;
+            helpers[i].index = i;
+            pthread_create(&threads[i], NULL, &work, &helpers[i]);
+        }
+        for (unsigned int i = 0; i < threads.size(); ++i) {
+            pthread_join(threads[i], NULL);
+            helper_time += helpers[i].cpu_time;
+        }
+        
+        // commit in order
+        std::vector<bool> machines(instance.num_machines, false);
+        std::vector<bool> services(instance.service.size(), false);
+        std::vector<bool> processes(instance.num_processes, false);
+        unsigned int accepted = 0;
+        
+        for (unsigned int j = 0; j < jobs.size(); ++j) {
+            if (jobs[j].result) {
+                accepted += commit(*state, jobs[j], machines, services, processes);
+                delete jobs[j].result;
+            }
+        }
+        
+        #ifdef LOGGING
+        std::cerr << identifier << " " << time(NULL) - start_time << " " << accepted << "/" << jobs.size() << " " << state->getCost() << std::endl;
+        #endif
+        
+        stale = accepted ? 0 : stale + 1;
+    }
+    
+    snapshot = NULL;
+    if (state->getCost() >= best_known->getCost()) {
+        delete state;
+        return NULL;
+    }
+    return state;
+}
+
+double PipelineSearch::getHelperTime () const
+{
+    return helper_time;
+}
@@ -0,0 +1,90 @@
+/*
+ * Authors: 
+ *   Felix Brandt <brandt@fzi.de>, 
+ *   Jochen Speck <speck@kit.edu>, 
+ *   Markus Voelker <markus.voelker@kit.edu>
+ *
+ * Copyright (c) 2012 Felix Brandt, Jochen Speck, Markus Voelker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining 
+ * a copy of this software and associated documentation files (the 
+ * "Software"), to deal in the Software without restriction, including 
+ * without limitation the rights to use, copy, modify, merge, publish, 
+ * distribute, sublicense, and/or sell copies of the Software, and to 
+ * permit persons to whom the Software is furnished to do so, subject to 
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included 
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#ifndef __ROADEF_PIPELINESEARCH_H__
+#define __ROADEF_PIPELINESEARCH_H__
+
+#include <vector>
+
+#include "BaseSearch.h"
+#include "RandomSearch.h"
+
+/**
+ * Solve batches of weighted random neighborhoods concurrently. All
+ * neighborhoods of a batch are built against the same solution and solved
+ * by helper threads, the results are committed in order. A result is
+ * accepted without further checks if none of its processes, machines and
+ * services was changed by an earlier result of the batch, as its cost
+ * change and feasibility then carry over unchanged.
+ */
+class PipelineSearch : public BaseSearch
+{
+protected:
+    struct Job {
+        ProcessList processes;
+        ReAssignment* result;
+    };
+    
+    struct Helper {
+        PipelineSearch* search;
+        unsigned int index;
+        /** CPU seconds the helper spent on its jobs */
+        double cpu_time;
+    };
+    
+    int identifier;
+    unsigned int size;
+    unsigned int batch;
+    
+    /** Reschedule engines, one per helper thread */
+    std::vector<RandomSearch*> solvers;
+    
+    /** Solution all jobs of the current batch start from */
+    const ReAssignment* snapshot;
+    std::vector<Job> jobs;
+    /** Next job to be taken by a helper */
+    volatile unsigned int next_job;
+    /** CPU seconds of all helpers in the last run */
+    double helper_time;
+    
+    /** Helper thread solving jobs until none is left */
+    static void* work (void* helper);
+    
+    /** Apply the moves of a result to the state if it does not overlap with earlier ones, true if it was */
+    bool commit (ReAssignment& state, const Job& job, std::vector<bool>& machines, std::vector<bool>& services, std::vector<bool>& processes);
+    
+public:
+    PipelineSearch (int identifier, time_t start_time, unsigned int helpers = 2, unsigned int batch = 16, unsigned int size = 7);
+    virtual ~PipelineSearch ();
+    
+    virtual ReAssignment* run (const ReAssignment* best_known, const TimeBudget& budget);
+    virtual double getHelperTime () const;
+};
+
+#endif /* __ROADEF_PIPELINESEARCH_H__ */
@@ -0,0 +1,235 @@
+/*
+ * Authors: 
+ *   Felix Brandt <brandt@fzi.de>, 
+ *   Jochen Speck <speck@kit.edu>, 
+ *   Markus Voelker <markus.voelker@kit.edu>
+ *
+ * Copyright (c) 2012 Felix Brandt, Jochen Speck, Markus Voelker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining 
+ * a copy of this software and associated documentation files (the 
+ * "Software"), to deal in the Software without restriction, including 
+ * without limitation the rights to use, copy, modify, merge, publish, 
+ * distribute, sublicense, and/or sell copies of the Software, and to 
+ * permit persons to whom the Software is furnished to do so, subject to 
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included 
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "ProcessCostIndex.h"
+
+ProcessCostIndex::ProcessCostIndex (bool _move_cost, long long _bias) :
+instance(NULL), fixing(NULL), fixing_version(0), move_cost(_move_cost), stamp(0), bias(_bias)
+{ }
+
+long long ProcessCostIndex::getReduction (const ReAssignment& state, unsigned int p) const
+{
+    const Process& process = instance->process[p];
+    int m = (int)state.assignment[p];
+    long long cost = 0;
+    
+    for (unsigned int r = 0; r < (unsigned int)instance->num_resources; ++r) {
+        int excess = state.excess[m][r];
+        cost += (std::max(0, excess) - std::max(0, excess - process.requirement[r])) * instance->resource[r].weight_load_cost;
+    }
+    
+    if (move_cost && m != process.original_machine) {
+        cost += process.move_cost * instance->weight_process_move_cost;
+        cost += instance->machine[process.original_machine].move_cost[m] * instance->weight_machine_move_cost;
+    }
+    
+    return cost;
+}
+
+void ProcessCostIndex::swapPositions (unsigned int i, unsigned int j)
+{
+    std::swap(heap[i], heap[j]);
+    position[heap[i]] = i;
+    position[heap[j]] = j;
+}
+
+void ProcessCostIndex::addWeight (unsigned int p, long long delta)
+{
+    for (unsigned int i = p + 1; i < weight.size(); i += i & (~i + 1)) {
+        weight[i] += delta;
+    }
+}
+
+unsigned int ProcessCostIndex::findWeight (long long value) const
+{
+    unsigned int step = 1;
+    while (2 * step < weight.size()) {
+        step *= 2;
+    }
+    
+    // descend the tree, p is the number of processes whose weights are passed
+    unsigned int p = 0;
+    for (; step > 0; step /= 2) {
+        if (p + step < weight.size() && weight[p + step] <= value) {
+            p += step;
+            value -= weight[p];
+        }
+    }
+    return p;
+}
+
+void ProcessCostIndex::setKey (unsigned int p, long long value)
+{
+    unsigned int i = position[p];
+    addWeight(p, value - key[p]);
+    key[p] = value;
+    
+    while (i > 0 && key[heap[(i - 1) / 2]] < key[heap[i]]) {
+        swapPositions(i, (i - 1) / 2);
+        i = (i - 1) / 2;
+    }
+    
+    while (true) {
+        unsigned int largest = i;
+        unsigned int left = 2 * i + 1;
+        unsigned int right = 2 * i + 2;
+        if (left < heap.size() && key[heap[largest]] < key[heap[left]]) largest = left;
+        if (right < heap.size() && key[heap[largest]] < key[heap[right]]) largest = right;
+        if (largest == i) break;
+        swapPositions(i, largest);
+        i = largest;
+    }
+}
+
+void ProcessCostIndex::update (const ReAssignment& state, const ProcessFixing& _fixing)
+{
+    std::vector<unsigned int> changed;
+    
+    bool rebuild = (instance != state.instance || fixing != &_fixing || fixing_version != _fixing.version);
+    int first = rebuild ? -1 : state.findMoves(stamp);
+    
+    if (first < 0) {
+        instance = state.instance;
+        fixing = &_fixing;
+        fixing_version = _fixing.version;
+        hosted.assign(instance->num_machines, ProcessList());
+        slot.assign(instance->num_processes, 0);
+        key.assign(instance->num_processes, 0);
+        heap.clear();
+        position.assign(instance->num_processes, -1);
+        weight.assign(instance->num_processes + 1, 0);
+        
+        for (unsigned int p = 0; p < state.assignment.size(); ++p) {
+            slot[p] = hosted[state.assignment[p]].size();
+            hosted[state.assignment[p]].push_back(p);
+            
+            if (!fixing->fixed[p]) {
+                position[p] = heap.size();
+                heap.push_back(p);
+                addWeight(p, bias);
+            }
+        }
+        
+        for (unsigned int m = 0; m < hosted.size(); ++m) {
+            changed.push_back(m);
+        }
+    } else {
+        for (unsigned int i = first; i < state.journal.size(); ++i) {
+            const ReAssignment::Move& move = state.journal[i];
+            
+            // swap remove from the old machine's list
+            ProcessList& old = hosted[move.from];
+            old[slot[move.process]] = old.back();
+            slot[old.back()] = slot[move.process];
+            old.pop_back();
+            
+            slot[move.process] = hosted[move.to].size();
+            hosted[move.to].push_back(move.process);
+            
+            changed.push_back(move.from);
+            changed.push_back(move.to);
+        }
+        std::sort(changed.begin(), changed.end());
+        changed.erase(std::unique(changed.begin(), changed.end()), changed.end());
+    }
+    stamp = state.stamp;
+    
+    for (unsigned int i = 0; i < changed.size(); ++i) {
+        const ProcessList& processes = hosted[changed[i]];
+        for (unsigned int j = 0; j < processes.size(); ++j) {
+            if (position[processes[j]] >= 0) {
+                setKey(processes[j], getReduction(state, processes[j]));
+            }
+        }
+    }
+}
+
+const ProcessList& ProcessCostIndex::getProcesses (unsigned int m) const
+{
+    return hosted[m];
+}
+
+unsigned int ProcessCostIndex::getCount () const
+{
+    return heap.size();
+}
+
+void ProcessCostIndex::sample (unsigned int count, ProcessList& processes, Random& random)
+{
+    processes.clear();
+    count = std::min(count, (unsigned int)heap.size());
+    
+    // drawn processes get no weight until all are drawn
+    while (processes.size() < count) {
+        long long total = 0;
+        for (unsigned int i = weight.size() - 1; i > 0; i -= i & (~i + 1)) {
+            total += weight[i];
+        }
+        if (total <= 0) {
+            break;
+        }
+        
+        long long value = random(total);
+        unsigned int p = findWeight(value);
+        processes.push_back(p);
+        addWeight(p, -(key[p] + bias));
+    }
+    
+    for (unsigned int i = 0; i < processes.size(); ++i) {
+        addWeight(processes[i], key[processes[i]] + bias);
+    }
+}
+
+ProcessCostIndex::Cursor::Cursor (const ProcessCostIndex& _index) :
+index(&_index)
+{
+    if (!index->heap.empty()) {
+        frontier.push(std::make_pair(index->key[index->heap[0]], 0u));
+    }
+}
+
+bool ProcessCostIndex::Cursor::next (ProcessCost& process)
+{
+    if (frontier.empty()) {
+        return false;
+    }
+    
+    unsigned int i = frontier.top().second;
+    frontier.pop();
+    
+    const std::vector<int>& heap = index->heap;
+    for (unsigned int c = 2 * i + 1; c <= 2 * i + 2 && c < heap.size(); ++c) {
+        frontier.push(std::make_pair(index->key[heap[c]], c));
+    }
+    
+    process = ProcessCost(heap[i], index->key[heap[i]]);
+    return true;
+}
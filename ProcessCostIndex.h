@@ -0,0 +1,110 @@
+/*
+ * Authors: 
+ *   Felix Brandt <brandt@fzi.de>, 
+ *   Jochen Speck <speck@kit.edu>, 
+ *   Markus Voelker <markus.voelker@kit.edu>
+ *
+ * Copyright (c) 2012 Felix Brandt, Jochen Speck, Markus Voelker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining 
+ * a copy of this software and associated documentation files (the 
+ * "Software"), to deal in the Software without restriction, including 
+ * without limitation the rights to use, copy, modify, merge, publish, 
+ * distribute, sublicense, and/or sell copies of the Software, and to 
+ * permit persons to whom the Software is furnished to do so, subject to 
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included 
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#ifndef __ROADEF_PROCESSCOSTINDEX_H__
+#define __ROADEF_PROCESSCOSTINDEX_H__
+
+#include <queue>
+#include <vector>
+
+#include "Instance.h"
+#include "ProcessFixing.h"
+#include "Random.h"
+
+/**
+ * Indexed max-heap of the cost reduction bound of each movable process (see
+ * IterativeSearch::process_cost). Only the processes on the machines of the
+ * moves applied since the last update are rescored, the moves are taken from
+ * the journal of the state. The most expensive processes are enumerated
+ * without sorting all of them. A Fenwick tree over the
+ * reductions plus a bias allows to sample processes proportionally.
+ */
+class ProcessCostIndex
+{
+protected:
+    const Instance* instance;
+    /** Fixed processes the heap is based on and their version */
+    const ProcessFixing* fixing;
+    unsigned int fixing_version;
+    /** Whether the move costs of a process count towards its reduction */
+    bool move_cost;
+    /** Stamp of the solution the heap is based on */
+    unsigned long long stamp;
+    /** Processes per machine */
+    std::vector<ProcessList> hosted;
+    /** Position of each process in its machine's list */
+    std::vector<unsigned int> slot;
+    
+    std::vector<long long> key;
+    /** Movable processes in heap order */
+    std::vector<int> heap;
+    /** Heap position of each process, -1 for fixed processes */
+    std::vector<int> position;
+    
+    /** Added to each reduction for sampling, so that every process can be drawn */
+    long long bias;
+    /** Fenwick tree over the sampling weights, indexed by process + 1 */
+    std::vector<long long> weight;
+    
+    long long getReduction (const ReAssignment& state, unsigned int process) const;
+    void setKey (unsigned int process, long long key);
+    void swapPositions (unsigned int i, unsigned int j);
+    void addWeight (unsigned int process, long long delta);
+    /** Process whose weight interval contains @c value */
+    unsigned int findWeight (long long value) const;
+    
+public:
+    /** Enumerates processes by decreasing reduction, the heap must not change meanwhile */
+    class Cursor
+    {
+    protected:
+        const ProcessCostIndex* index;
+        /** Reductions and heap positions of the next candidates */
+        std::priority_queue<std::pair<long long, unsigned int> > frontier;
+        
+    public:
+        Cursor (const ProcessCostIndex& index);
+        
+        /** Next process and its reduction, false when all processes have been returned */
+        bool next (ProcessCost& process);
+    };
+    
+    ProcessCostIndex (bool move_cost = true, long long bias = 10);
+    
+    /** Rescore the processes on the machines of the moves since the last update, all processes if the fixing changed or the journal does not reach back */
+    void update (const ReAssignment& state, const ProcessFixing& fixing);
+    /** Processes on a machine in the last updated state */
+    const ProcessList& getProcesses (unsigned int machine) const;
+    /** Number of movable processes */
+    unsigned int getCount () const;
+    /** Draw distinct movable processes with probability proportional to their reduction plus the bias */
+    void sample (unsigned int count, ProcessList& processes, Random& random);
+};
+
+#endif /* __ROADEF_PROCESSCOSTINDEX_H__ */
@@ -31,25 +31,28 @@
 #include <algorithm>
 #include "ProcessFixing.h"
 
-ProcessFixing::ProcessFixing(Instance& instance) : instance(instance) {}
+ProcessFixing::ProcessFixing(const Instance& instance) : instance(instance), version(0) {
+    reset();
+}
 
 void ProcessFixing::reset() {
-    for (int p = 0; p < instance.num_processes; p++)
-        instance.process[p].fixed = false;
-    instance.movable_processes_by_size = std::vector<int>(instance.processes_by_size);
-    instance.num_movable_processes = instance.num_processes;
+    fixed.assign(instance.num_processes, false);
+    movable_processes_by_size = std::vector<int>(instance.processes_by_size);
+    num_movable_processes = instance.num_processes;
+    version++;
 }
 
 void ProcessFixing::updateMovableProcesses() {
     int count = 0;
-    instance.movable_processes_by_size = std::vector<int>(instance.num_processes);
+    movable_processes_by_size = std::vector<int>(instance.num_processes);
     for (int i = 0; i < instance.num_processes; i++) {
         int p = instance.processes_by_size[i];
-        if (!instance.process[p].fixed)
-            instance.movable_processes_by_size[count++] = p;
+        if (!fixed[p])
+            movable_processes_by_size[count++] = p;
     }
-    instance.movable_processes_by_size.resize(count);
-    instance.num_movable_processes = count;
+    movable_processes_by_size.resize(count);
+    num_movable_processes = count;
+    version++;
     #ifdef LOGGING
     std::cerr << "Fixed processes: " << instance.num_processes - count << "/" << instance.num_processes << std::endl;    
     #endif
@@ -106,7 +109,7 @@ void ProcessFixing::fixTransient(float safety) {
         }
         
         if (has_space) {
-            instance.process[p].fixed = true;
+            fixed[p] = true;
             num_fixed++;
             for (int r = 0; r < instance.num_resources; r++) {
                 fixed_usage[m][r] += instance.process[p].requirement[r];
@@ -32,11 +32,22 @@
 
 #include "Instance.h"
 
+/**
+ * Processes of one worker currently not available for reassignment. The
+ * instance is only read, so every worker can keep its own fixing.
+ */
 class ProcessFixing {
 public:
-    Instance& instance;
+    const Instance& instance;
+    
+    std::vector<bool> fixed;
+    // process ids of movable processes in order of increasing resource demand
+    std::vector<int> movable_processes_by_size;
+    int num_movable_processes;
+    // incremented on every change, so that indices know when to rebuild
+    unsigned int version;
     
-    ProcessFixing(Instance& instance);
+    ProcessFixing(const Instance& instance);
     
     void reset();
     void updateMovableProcesses();
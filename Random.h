@@ -0,0 +1,56 @@
+/*
+ * Authors: 
+ *   Felix Brandt <brandt@fzi.de>, 
+ *   Jochen Speck <speck@kit.edu>, 
+ *   Markus Voelker <markus.voelker@kit.edu>
+ *
+ * Copyright (c) 2012 Felix Brandt, Jochen Speck, Markus Voelker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining 
+ * a copy of this software and associated documentation files (the 
+ * "Software"), to deal in the Software without restriction, including 
+ * without limitation the rights to use, copy, modify, merge, publish, 
+ * distribute, sublicense, and/or sell copies of the Software, and to 
+ * permit persons to whom the Software is furnished to do so, subject to 
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included 
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#ifndef __ROADEF_RANDOM_H__
+#define __ROADEF_RANDOM_H__
+
+/**
+ * Fast pseudo random number generator (xoshiro256**) owned by a single
+ * thread. Generators with the same seed and stream return the same numbers,
+ * independent of what other threads draw.
+ */
+class Random
+{
+protected:
+    unsigned long long state[4];
+    
+public:
+    Random (unsigned long long seed = 0, unsigned long long stream = 0);
+    
+    /** Restart the generator on the sequence of the given seed and stream */
+    void seed (unsigned long long seed, unsigned long long stream = 0);
+    
+    unsigned long long next ();
+    /** Uniform number in [0, n), usable as generator of std::random_shuffle */
+    unsigned long long operator() (unsigned long long n) { return next() % n; }
+    /** Uniform number in [0, 1) */
+    double real () { return (next() >> 11) * (1.0 / 9007199254740992.0); }
+};
+
+#endif /* __ROADEF_RANDOM_H__ */
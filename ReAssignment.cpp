@@ -26,8 +26,118 @@
  * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
 
+#include <algorithm>
+
 #include "ReAssignment.h"
 
-long long ReAssignment::getCost() {
+unsigned int ReAssignment::journal_size = 256;
+
+/** Source of the stamps, shared by all threads */
+static unsigned long long last_stamp = 0;
+
+static unsigned long long nextStamp ()
+{
+    return __sync_add_and_fetch(&last_stamp, 1);
+}
+
+ReAssignment::ReAssignment () :
+instance(NULL), load_cost(0), balance_cost(0), process_moves(0), machine_moves(0), stamp(nextStamp()), origin(stamp)
+{ }
+
+long long ReAssignment::getCost() const {
     return load_cost + balance_cost + process_moves * instance->weight_process_move_cost + machine_moves * instance->weight_machine_move_cost;
 }
+
+void ReAssignment::move (unsigned int p, unsigned int m)
+{
+    const Process& process = instance->process[p];
+    unsigned int old = assignment[p];
+    
+    if (old == m) {
+        return;
+    }
+    
+    long long cost = getCost();
+    
+    for (unsigned int r = 0; r < instance->resource.size(); ++r) {
+        long long weight = instance->resource[r].weight_load_cost;
+        int requirement = process.requirement[r];
+        
+        load_cost += (std::max(0, excess[old][r] - requirement) - std::max(0, excess[old][r])) * weight;
+        load_cost += (std::max(0, excess[m][r] + requirement) - std::max(0, excess[m][r])) * weight;
+        excess[old][r] -= requirement;
+        excess[m][r] += requirement;
+        
+        // the original machine keeps the transient usage
+        if (r < instance->transient_count) {
+            if (process.original_machine != (int)old) {
+                transient[old][r] -= requirement;
+            }
+            if (process.original_machine != (int)m) {
+                transient[m][r] += requirement;
+            }
+        }
+    }
+    
+    for (unsigned int b = 0; b < instance->balance.size(); ++b) {
+        const Balance& bal = instance->balance[b];
+        int process_balance = process.requirement[bal.resource2] - bal.balance * process.requirement[bal.resource1];
+        long long weight = bal.weight_balance_cost;
+        
+        balance_cost += (std::max(0, balance[old][b] - process_balance) - std::max(0, balance[old][b])) * weight;
+        balance_cost += (std::max(0, balance[m][b] + process_balance) - std::max(0, balance[m][b])) * weight;
+        balance[old][b] -= process_balance;
+        balance[m][b] += process_balance;
+    }
+    
+    if (process.original_machine == (int)old) {
+        process_moves += process.move_cost;
+    } else if (process.original_machine == (int)m) {
+        process_moves -= process.move_cost;
+    }
+    
+    const Machine& original = instance->machine[process.original_machine];
+    machine_moves += (long long)original.move_cost[m] - (long long)original.move_cost[old];
+    
+    assignment[p] = m;
+    record(p, old, getCost() - cost);
+}
+
+void ReAssignment::record (unsigned int p, unsigned int from, long long cost)
+{
+    if (journal.empty()) {
+        origin = stamp;
+    }
+    
+    stamp = nextStamp();
+    Move move = { p, from, assignment[p], cost, stamp };
+    journal.push_back(move);
+    
+    if (journal.size() > 2 * (size_t)journal_size) {
+        origin = (journal.end() - journal_size - 1)->stamp;
+        journal.erase(journal.begin(), journal.end() - journal_size);
+    }
+}
+
+void ReAssignment::restart ()
+{
+    stamp = nextStamp();
+    origin = stamp;
+    journal.clear();
+}
+
+int ReAssignment::findMoves (unsigned long long since) const
+{
+    if (since == stamp) {
+        return (int)journal.size();
+    }
+    if (since == origin) {
+        return 0;
+    }
+    for (int i = (int)journal.size() - 1; i >= 0; --i) {
+        if (journal[i].stamp == since) {
+            return i + 1;
+        }
+    }
+    return -1;
+}
@@ -30,12 +30,29 @@
 #ifndef ReAssignment_h
 #define ReAssignment_h
 
+#include <vector>
+
 #include "Instance.h"
 
 class ReAssignment
 {
 public:
-    Instance *instance;
+    /** A process move and the cost change it caused */
+    struct Move
+    {
+        unsigned int process;
+        unsigned int from;
+        unsigned int to;
+        /** Cost change, moves applied together may carry their joint change on the last one */
+        long long cost;
+        /** Stamp of the solution the move led to */
+        unsigned long long stamp;
+    };
+    
+    /** Number of moves kept in the journal, older ones are dropped in blocks */
+    static unsigned int journal_size;
+    
+    const Instance *instance;
     Assignment assignment;
     InstanceLoad excess;
     InstanceLoad transient;
@@ -46,7 +63,25 @@ public:
     long long process_moves;
     long long machine_moves;
     
-    long long getCost();
+    /** Identifies the assignment, copies share it and every move draws a new one */
+    unsigned long long stamp;
+    /** Latest moves leading to this solution, oldest first */
+    std::vector<Move> journal;
+    /** Stamp of the solution the oldest move in the journal was applied to */
+    unsigned long long origin;
+    
+    ReAssignment ();
+    
+    long long getCost() const;
+    
+    /** Move a process to another machine and update loads and costs */
+    void move (unsigned int process, unsigned int machine);
+    /** Log a move whose assignment, loads and costs were already changed */
+    void record (unsigned int process, unsigned int from, long long cost);
+    /** Drop the journal after the assignment was set as a whole */
+    void restart ();
+    /** Position of the first move after the solution with the given stamp, -1 if the journal does not reach back to it */
+    int findMoves (unsigned long long stamp) const;
 };
 
 #endif /* __ROADEF_REASSIGNMENT_H__ */
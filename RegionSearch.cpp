@@ -0,0 +1,67 @@
+/*
+ * Authors: 
+ *   Felix Brandt <brandt@fzi.de>, 
+ *   Jochen Speck <speck@kit.edu>, 
+ *   Markus Voelker <markus.voelker@kit.edu>
+ *
+ * Copyright (c) 2012 Felix Brandt, Jochen Speck, Markus Voelker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining 
+ * a copy of this software and associated documentation files (the 
+ * "Software"), to deal in the Software without restriction, including 
+ * without limitation the rights to use, copy, modify, merge, publish, 
+ * distribute, sublicense, and/or sell copies of the Software, and to 
+ * permit persons to whom the Software is furnished to do so, subject to 
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included 
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "RegionSearch.h"
+
+RegionSearch::RegionSearch (int identifier, time_t start_time, unsigned int _region, unsigned int _regions, int _neighborhood, double _epoch, unsigned int _period) :
+IterativeSearch(identifier, start_time, false), neighborhood(_neighborhood), region(_region), epoch(_epoch), period(std::max(1u, _period)), regions(_regions)
+{ }
+
+RegionSearch::~RegionSearch ()
+{ }
+
+ReAssignment* RegionSearch::runOnce (const ReAssignment* state)
+{
+    const Instance& instance = *state->instance;
+    
+    regions.update(instance, (long long)((TimeBudget::now() - epoch) / period));
+    const ProcessList& machines = regions.getMachines(region % regions.getCount());
+    allowed = &regions.getMask(region % regions.getCount());
+    if (machines.empty())
+        return NULL;
+    
+    costs->update(*state, *fixing);
+    
+    // random movable processes hosted in the region
+    unsigned int size = controller.scale(neighborhood);
+    ProcessList n;
+    for (unsigned int t = 0; t < 4 * size && n.size() < size; ++t) {
+        const ProcessList& hosted = costs->getProcesses(machines[random(machines.size())]);
+        if (hosted.empty())
+            continue;
+        
+        unsigned int p = hosted[random(hosted.size())];
+        if (!fixing->fixed[p] && std::find(n.begin(), n.end(), p) == n.end())
+            n.push_back(p);
+    }
+    if (n.empty())
+        return NULL;
+    std::sort(n.begin(), n.end());
+    
+    return reschedule(*state, n);
+}
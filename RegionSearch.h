@@ -0,0 +1,61 @@
+/*
+ * Authors: 
+ *   Felix Brandt <brandt@fzi.de>, 
+ *   Jochen Speck <speck@kit.edu>, 
+ *   Markus Voelker <markus.voelker@kit.edu>
+ *
+ * Copyright (c) 2012 Felix Brandt, Jochen Speck, Markus Voelker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining 
+ * a copy of this software and associated documentation files (the 
+ * "Software"), to deal in the Software without restriction, including 
+ * without limitation the rights to use, copy, modify, merge, publish, 
+ * distribute, sublicense, and/or sell copies of the Software, and to 
+ * permit persons to whom the Software is furnished to do so, subject to 
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included 
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#ifndef __ROADEF_REGIONSEARCH_H__
+#define __ROADEF_REGIONSEARCH_H__
+
+#include "IterativeSearch.h"
+#include "MachineRegions.h"
+
+/**
+ * Random local search confined to the machines of one region. All workers
+ * run it during the same region phases and their runs end with the round,
+ * so concurrent runs change disjoint machines. Services still span several
+ * regions, the moves are therefore checked when merged into the incumbent.
+ */
+class RegionSearch : public IterativeSearch
+{
+protected:
+    int neighborhood;
+    unsigned int region;
+    /** Monotonic time all workers count their rounds from */
+    double epoch;
+    /** Seconds until the regions are reshuffled */
+    unsigned int period;
+    
+    MachineRegions regions;
+    
+public:
+    RegionSearch (int identifier, time_t start_time, unsigned int region, unsigned int regions, int neighborhood_size, double epoch, unsigned int period = 10);
+    virtual ~RegionSearch ();
+    
+    virtual ReAssignment* runOnce (const ReAssignment* state);
+};
+
+#endif /* __ROADEF_REGIONSEARCH_H__ */
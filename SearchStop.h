@@ -0,0 +1,55 @@
+/*
+ * Authors: 
+ *   Felix Brandt <brandt@fzi.de>, 
+ *   Jochen Speck <speck@kit.edu>, 
+ *   Markus Voelker <markus.voelker@kit.edu>
+ *
+ * Copyright (c) 2012 Felix Brandt, Jochen Speck, Markus Voelker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining 
+ * a copy of this software and associated documentation files (the 
+ * "Software"), to deal in the Software without restriction, including 
+ * without limitation the rights to use, copy, modify, merge, publish, 
+ * distribute, sublicense, and/or sell copies of the Software, and to 
+ * permit persons to whom the Software is furnished to do so, subject to 
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included 
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#ifndef __ROADEF_SEARCHSTOP_H__
+#define __ROADEF_SEARCHSTOP_H__
+
+#include <gecode/search.hh>
+
+#include "BaseSearch.h"
+
+/**
+ * Stop a Gecode search after a number of failures, when the time of the
+ * search strategy running it is used up or when it has been interrupted.
+ */
+class SearchStop : public Gecode::Search::Stop
+{
+protected:
+    unsigned long int fail_limit;
+    const BaseSearch* search;
+    /** Calls so far, time and interruption are only polled every 64 calls */
+    unsigned int calls;
+    
+public:
+    SearchStop (unsigned long int fail_limit, const BaseSearch* search);
+    
+    virtual bool stop (const Gecode::Search::Statistics& s, const Gecode::Search::Options& o);
+};
+
+#endif /* __ROADEF_SEARCHSTOP_H__ */
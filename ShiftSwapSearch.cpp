@@ -0,0 +1,350 @@
+/*
+ * Authors: 
+ *   Felix Brandt <brandt@fzi.de>, 
+ *   Jochen Speck <speck@kit.edu>, 
+ *   Markus Voelker <markus.voelker@kit.edu>
+ *
+ * Copyright (c) 2012 Felix Brandt, Jochen Speck, Markus Voelker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining 
+ * a copy of this software and associated documentation files (the 
+ * "Software"), to deal in the Software without restriction, including 
+ * without limitation the rights to use, copy, modify, merge, publish, 
+ * distribute, sublicense, and/or sell copies of the Software, and to 
+ * permit persons to whom the Software is furnished to do so, subject to 
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included 
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <algorithm>
+#include <stdlib.h>
+
+#include "ShiftSwapSearch.h"
+
+ShiftSwapSearch::ShiftSwapSearch (int _identifier, time_t start_time, unsigned int _swap_machines) :
+BaseSearch(start_time),
+identifier(_identifier), swap_machines(_swap_machines), last(0), state(NULL)
+{ }
+
+ShiftSwapSearch::~ShiftSwapSearch ()
+{ }
+
+void ShiftSwapSearch::setup (const ReAssignment& best_known)
+{
+    state = new ReAssignment(best_known);
+    const Instance& instance = *state->instance;
+    
+    hosted.assign(instance.num_machines, ProcessList());
+    for (unsigned int p = 0; p < (unsigned int)instance.num_processes; ++p) {
+        if (!fixing->fixed[p]) {
+            hosted[state->assignment[p]].push_back(p);
+        }
+    }
+    
+    service_machines.assign(instance.service.size(), std::set<unsigned int>());
+    location_count.assign(instance.service.size(), std::map<unsigned int, int>());
+    neighborhood_count.assign(instance.service.size(), std::map<unsigned int, int>());
+    spread.assign(instance.service.size(), 0);
+    
+    for (unsigned int s = 0; s < instance.service.size(); ++s) {
+        const ProcessList& members = instance.service[s].process;
+        
+        for (ProcessList::const_iterator p = members.begin(); p != members.end(); ++p) {
+            const Machine& machine = instance.machine[state->assignment[*p]];
+            service_machines[s].insert(state->assignment[*p]);
+            location_count[s][machine.location]++;
+            neighborhood_count[s][machine.neighborhood]++;
+        }
+        
+        spread[s] = (unsigned int)location_count[s].size();
+    }
+}
+
+long long ShiftSwapSearch::getMachineDelta (unsigned int m, const Process* out, const Process* in, bool& fits) const
+{
+    const Instance& instance = *state->instance;
+    const Machine& machine = instance.machine[m];
+    const MachineLoad& excess = state->excess[m];
+    long long delta = 0;
+    
+    fits = true;
+    
+    for (unsigned int r = 0; r < (unsigned int)instance.num_resources; ++r) {
+        int change = (in ? in->requirement[r] : 0) - (out ? out->requirement[r] : 0);
+        
+        if (excess[r] + change > machine.capacity[r] - machine.safety_capacity[r]) {
+            fits = false;
+        }
+        
+        delta += (std::max(0, excess[r] + change) - std::max(0, excess[r])) * (long long)instance.resource[r].weight_load_cost;
+    }
+    
+    // the original machine keeps the transient usage of its processes
+    for (unsigned int r = 0; r < instance.transient_count; ++r) {
+        int change = 0;
+        if (in && in->original_machine != (int)m) {
+            change += in->requirement[r];
+        }
+        if (out && out->original_machine != (int)m) {
+            change -= out->requirement[r];
+        }
+        
+        if (change > 0 && state->transient[m][r] + change > machine.capacity[r]) {
+            fits = false;
+        }
+    }
+    
+    for (unsigned int b = 0; b < instance.balance.size(); ++b) {
+        const Balance& bal = instance.balance[b];
+        int change = 0;
+        if (in) {
+            change += in->requirement[bal.resource2] - bal.balance * in->requirement[bal.resource1];
+        }
+        if (out) {
+            change -= out->requirement[bal.resource2] - bal.balance * out->requirement[bal.resource1];
+        }
+        
+        int value = state->balance[m][b];
+        delta += (std::max(0, value + change) - std::max(0, value)) * (long long)bal.weight_balance_cost;
+    }
+    
+    return delta;
+}
+
+long long ShiftSwapSearch::getMoveDelta (const Process& process, unsigned int from, unsigned int to) const
+{
+    const Instance& instance = *state->instance;
+    const Machine& original = instance.machine[process.original_machine];
+    long long delta = 0;
+    
+    if (process.original_machine == (int)from) {
+        delta += process.move_cost;
+    } else if (process.original_machine == (int)to) {
+        delta -= process.move_cost;
+    }
+    delta *= instance.weight_process_move_cost;
+    
+    delta += ((long long)original.move_cost[to] - (long long)original.move_cost[from]) * instance.weight_machine_move_cost;
+    
+    return delta;
+}
+
+bool ShiftSwapSearch::allowed (unsigned int p, unsigned int from, unsigned int to) const
+{
+    const Instance& instance = *state->instance;
+    unsigned int s = instance.process[p].service;
+    const Service& service = instance.service[s];
+    
+    // conflict
+    if (service_machines[s].count(to)) {
+        return false;
+    }
+    
+    // spread
+    unsigned int l1 = instance.machine[from].location;
+    unsigned int l2 = instance.machine[to].location;
+    if (l1 != l2) {
+        std::map<unsigned int, int>::const_iterator c1 = location_count[s].find(l1);
+        std::map<unsigned int, int>::const_iterator c2 = location_count[s].find(l2);
+        
+        unsigned int covered = spread[s];
+        if (c1->second == 1) {
+            covered--;
+        }
+        if (c2 == location_count[s].end() || c2->second == 0) {
+            covered++;
+        }
+        
+        if (covered < service.min_spread) {
+            return false;
+        }
+    }
+    
+    // dependency
+    unsigned int n1 = instance.machine[from].neighborhood;
+    unsigned int n2 = instance.machine[to].neighborhood;
+    if (n1 != n2) {
+        for (ServiceList::const_iterator d = service.depends_on.begin(); d != service.depends_on.end(); ++d) {
+            std::map<unsigned int, int>::const_iterator c = neighborhood_count[*d].find(n2);
+            if (c == neighborhood_count[*d].end() || c->second == 0) {
+                return false;
+            }
+        }
+        
+        // leaving the last neighborhood of the service
+        if (neighborhood_count[s].find(n1)->second == 1) {
+            for (ServiceList::const_iterator d = service.required_by.begin(); d != service.required_by.end(); ++d) {
+                std::map<unsigned int, int>::const_iterator c = neighborhood_count[*d].find(n1);
+                if (c != neighborhood_count[*d].end() && c->second > 0) {
+                    return false;
+                }
+            }
+        }
+    }
+    
+    return true;
+}
+
+void ShiftSwapSearch::update (unsigned int p, unsigned int from, unsigned int to)
+{
+    const Instance& instance = *state->instance;
+    unsigned int s = instance.process[p].service;
+    
+    service_machines[s].erase(from);
+    service_machines[s].insert(to);
+    
+    if (--location_count[s][instance.machine[from].location] == 0) {
+        spread[s]--;
+    }
+    if (++location_count[s][instance.machine[to].location] == 1) {
+        spread[s]++;
+    }
+    
+    neighborhood_count[s][instance.machine[from].neighborhood]--;
+    neighborhood_count[s][instance.machine[to].neighborhood]++;
+}
+
+void ShiftSwapSearch::apply (unsigned int p, unsigned int to)
+{
+    unsigned int from = state->assignment[p];
+    
+    state->move(p, to);
+    update(p, from, to);
+    
+    hosted[from].erase(std::find(hosted[from].begin(), hosted[from].end(), p));
+    hosted[to].push_back(p);
+}
+
+bool ShiftSwapSearch::shift (unsigned int p)
+{
+    const Instance& instance = *state->instance;
+    const Process& process = instance.process[p];
+    unsigned int from = state->assignment[p];
+    unsigned int machines = instance.num_machines;
+    
+    bool fits;
+    long long leave = getMachineDelta(from, &process, NULL, fits);
+    
+    targets.clear();
+    
+    // random start, so repeated runs do not favor low machine ids
+    unsigned int start = random(machines);
+    for (unsigned int i = 0; i < machines; ++i) {
+        unsigned int m = (start + i) % machines;
+        if (m == from) {
+            continue;
+        }
+        
+        long long delta = leave + getMachineDelta(m, NULL, &process, fits) + getMoveDelta(process, from, m);
+        
+        if (fits && delta < 0 && allowed(p, from, m)) {
+            apply(p, m);
+            return true;
+        }
+        
+        // remember the cheapest targets regardless of capacity for the swaps
+        if (targets.size() < swap_machines) {
+            targets.push_back(std::pair<long long, unsigned int>(delta, m));
+            std::push_heap(targets.begin(), targets.end());
+        } else if (swap_machines > 0 && delta < targets.front().first) {
+            std::pop_heap(targets.begin(), targets.end());
+            targets.back() = std::pair<long long, unsigned int>(delta, m);
+            std::push_heap(targets.begin(), targets.end());
+        }
+    }
+    
+    return false;
+}
+
+bool ShiftSwapSearch::swap (unsigned int p)
+{
+    const Instance& instance = *state->instance;
+    const Process& process = instance.process[p];
+    unsigned int m1 = state->assignment[p];
+    
+    std::sort_heap(targets.begin(), targets.end());
+    
+    for (unsigned int t = 0; t < targets.size(); ++t) {
+        unsigned int m2 = targets[t].second;
+        
+        for (ProcessList::const_iterator q = hosted[m2].begin(); q != hosted[m2].end(); ++q) {
+            const Process& other = instance.process[*q];
+            
+            bool fits1, fits2;
+            long long delta = getMachineDelta(m1, &process, &other, fits1) + getMachineDelta(m2, &other, &process, fits2);
+            delta += getMoveDelta(process, m1, m2) + getMoveDelta(other, m2, m1);
+            
+            if (!fits1 || !fits2 || delta >= 0) {
+                continue;
+            }
+            
+            // swapping within a service changes no service data
+            bool valid = process.service == other.service;
+            if (!valid && allowed(p, m1, m2)) {
+                // check the second shift on top of the first one
+                update(p, m1, m2);
+                valid = allowed(*q, m2, m1);
+                update(p, m2, m1);
+            }
+            
+            if (valid) {
+                unsigned int partner = *q;
+                apply(p, m2);
+                apply(partner, m1);
+                return true;
+            }
+        }
+    }
+    
+    return false;
+}
+
+ReAssignment* ShiftSwapSearch::run (const ReAssignment* best_known, const TimeBudget& _budget)
+{
+    budget = _budget;
+    setup(*best_known);
+    
+    long long initial_cost = state->getCost();
+    base_cost = initial_cost;
+    unsigned int movable = fixing->num_movable_processes;
+    unsigned int stale = 0;
+    
+    // stop after a full pass over all movable processes without improvement
+    while (stale < movable && !expired() && !interrupted()) {
+        if (last >= movable) {
+            last = 0;
+        }
+        
+        unsigned int p = fixing->movable_processes_by_size[last++];
+        
+        if (shift(p) || swap(p)) {
+            stale = 0;
+        } else {
+            stale++;
+        }
+    }
+    
+    ReAssignment* result = state;
+    state = NULL;
+    
+    if (result->getCost() >= initial_cost) {
+        delete result;
+        return NULL;
+    }
+    
+    #ifdef LOGGING
+    std::cerr << identifier << " " << time(NULL) - start_time << " " << result->getCost() << std::endl;
+    #endif
+    
+    return result;
+}
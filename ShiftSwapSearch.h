@@ -0,0 +1,94 @@
+/*
+ * Authors: 
+ *   Felix Brandt <brandt@fzi.de>, 
+ *   Jochen Speck <speck@kit.edu>, 
+ *   Markus Voelker <markus.voelker@kit.edu>
+ *
+ * Copyright (c) 2012 Felix Brandt, Jochen Speck, Markus Voelker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining 
+ * a copy of this software and associated documentation files (the 
+ * "Software"), to deal in the Software without restriction, including 
+ * without limitation the rights to use, copy, modify, merge, publish, 
+ * distribute, sublicense, and/or sell copies of the Software, and to 
+ * permit persons to whom the Software is furnished to do so, subject to 
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included 
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#ifndef __ROADEF_SHIFTSWAPSEARCH_H__
+#define __ROADEF_SHIFTSWAPSEARCH_H__
+
+#include <map>
+#include <set>
+#include <vector>
+
+#include "BaseSearch.h"
+
+/**
+ * First improvement hill climbing with single process shifts and swaps of
+ * two processes. Moves are evaluated in O(R+B) on the machine rows and
+ * applied directly to a working copy of the state, the conflict, spread
+ * and dependency data of all services is kept up to date incrementally.
+ */
+class ShiftSwapSearch : public BaseSearch
+{
+protected:
+    int identifier;
+    /** Number of cheapest target machines whose processes are tried for swaps */
+    unsigned int swap_machines;
+    /** Position in the movable processes where the next run continues */
+    unsigned int last;
+    
+    /** Working copy of the state */
+    ReAssignment* state;
+    /** Movable processes per machine */
+    std::vector<ProcessList> hosted;
+    /** Machines used per service */
+    std::vector<std::set<unsigned int> > service_machines;
+    /** Processes per location and service */
+    std::vector<std::map<unsigned int, int> > location_count;
+    /** Processes per neighborhood and service */
+    std::vector<std::map<unsigned int, int> > neighborhood_count;
+    /** Number of locations used per service */
+    std::vector<unsigned int> spread;
+    /** Cheapest shift targets of the last process, used as swap partners */
+    std::vector<std::pair<long long, unsigned int> > targets;
+    
+    /** Build the working copy and the service data */
+    void setup (const ReAssignment& best_known);
+    /** Cost change on a machine if @c out leaves and @c in arrives (either may be NULL) */
+    long long getMachineDelta (unsigned int machine, const Process* out, const Process* in, bool& fits) const;
+    /** Change of the weighted process and machine move cost */
+    long long getMoveDelta (const Process& process, unsigned int from, unsigned int to) const;
+    /** Conflict, spread and dependency check for a single shift */
+    bool allowed (unsigned int process, unsigned int from, unsigned int to) const;
+    /** Update the service data for a shift */
+    void update (unsigned int process, unsigned int from, unsigned int to);
+    /** Apply a shift to the working copy */
+    void apply (unsigned int process, unsigned int to);
+    
+    /** Apply the first improving shift of the process */
+    bool shift (unsigned int process);
+    /** Apply the first improving swap with a process on one of the cheapest targets */
+    bool swap (unsigned int process);
+    
+public:
+    ShiftSwapSearch (int identifier, time_t start_time, unsigned int swap_machines = 8);
+    virtual ~ShiftSwapSearch ();
+    
+    virtual ReAssignment* run (const ReAssignment* best_known, const TimeBudget& budget);
+};
+
+#endif /* __ROADEF_SHIFTSWAPSEARCH_H__ */
@@ -0,0 +1,145 @@
+/*
+ * Authors: 
+ *   Felix Brandt <brandt@fzi.de>, 
+ *   Jochen Speck <speck@kit.edu>, 
+ *   Markus Voelker <markus.voelker@kit.edu>
+ *
+ * Copyright (c) 2012 Felix Brandt, Jochen Speck, Markus Voelker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining 
+ * a copy of this software and associated documentation files (the 
+ * "Software"), to deal in the Software without restriction, including 
+ * without limitation the rights to use, copy, modify, merge, publish, 
+ * distribute, sublicense, and/or sell copies of the Software, and to 
+ * permit persons to whom the Software is furnished to do so, subject to 
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included 
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include "SpreadPropagator.h"
+
+using namespace Gecode;
+using namespace std;
+
+SpreadPropagator::SpreadPropagator (Home home, ViewArray<Int::IntView>& machine, const std::vector<unsigned int>& locations, unsigned int min_spread) :
+Propagator(home),
+m_machine(machine),
+m_covered((unsigned int)locations.size()), m_min_spread(min_spread)
+{
+    // every moved process adds at most one location
+    m_location = static_cast<Space&>(home).alloc<unsigned int>(m_covered + m_machine.size());
+    std::copy(locations.begin(), locations.end(), m_location);
+    
+    m_machine.subscribe(home, *this, Int::PC_INT_VAL);
+}
+
+SpreadPropagator::SpreadPropagator (Home home, bool share, SpreadPropagator& p) :
+Propagator(home, share, p),
+m_covered(p.m_covered), m_min_spread(p.m_min_spread)
+{
+    m_machine.update(home, share, p.m_machine);
+    
+    m_location = static_cast<Space&>(home).alloc<unsigned int>(m_covered + m_machine.size());
+    std::copy(p.m_location, p.m_location + m_covered, m_location);
+}
+
+SpreadPropagator* SpreadPropagator::copy (Space& home, bool share)
+{
+    return new (home) SpreadPropagator(home, share, *this);
+}
+
+size_t SpreadPropagator::dispose (Space& home)
+{
+    m_machine.cancel(home, *this, Int::PC_INT_VAL);
+    
+    (void) Propagator::dispose(home);
+    
+    return sizeof(*this);
+}
+
+PropCost SpreadPropagator::cost (const Space& home, const ModEventDelta& delta) const
+{
+    return PropCost::linear(PropCost::LO, m_machine.size());
+}
+
+bool SpreadPropagator::covers (unsigned int location) const
+{
+    for (unsigned int i = 0; i < m_covered; ++i) {
+        if (m_location[i] == location) {
+            return true;
+        }
+    }
+    
+    return false;
+}
+
+ExecStatus SpreadPropagator::propagate (Space& home, const ModEventDelta& delta)
+{
+    const Instance& instance = static_cast<RescheduleSpace&>(home).instance;
+    
+    // collect the locations of newly assigned processes and stop watching them
+    for (int i = m_machine.size() - 1; i >= 0; --i) {
+        if (m_machine[i].assigned()) {
+            unsigned int location = instance.machine[m_machine[i].val()].location;
+            if (!covers(location)) {
+                m_location[m_covered++] = location;
+            }
+            m_machine.move_lst(i, home, *this, Int::PC_INT_VAL);
+        }
+    }
+    
+    if (m_covered >= m_min_spread) {
+        return home.ES_SUBSUMED(*this);
+    }
+    
+    unsigned int missing = m_min_spread - m_covered;
+    
+    if ((unsigned int)m_machine.size() < missing) {
+        return ES_FAILED;
+    }
+    
+    if ((unsigned int)m_machine.size() > missing) {
+        return ES_FIX;
+    }
+    
+    // each remaining process has to open a new location
+    for (int i = 0; i < m_machine.size(); ++i) {
+        for (unsigned int l = 0; l < m_covered; ++l) {
+            const ProcessList& machines = instance.location[m_location[l]];
+            for (ProcessList::const_iterator m = machines.begin(); m != machines.end(); ++m) {
+                GECODE_ME_CHECK(m_machine[i].nq(home, (int)(*m)));
+            }
+        }
+    }
+    
+    return ES_NOFIX;
+}
+
+ExecStatus SpreadPropagator::post (Gecode::Home home, const std::vector<unsigned int>& index, const std::vector<unsigned int>& locations, unsigned int min_spread)
+{
+    if (home.failed()) {
+        return ES_FAILED;
+    }
+    
+    RescheduleSpace& space = static_cast<RescheduleSpace&>((Space&)(home));
+    
+    ViewArray<Int::IntView> machine(space, (int)index.size());
+    for (unsigned int i = 0; i < index.size(); ++i) {
+        machine[i] = Int::IntView(space.process[index[i]]);
+    }
+    
+    new (home) SpreadPropagator (home, machine, locations, min_spread);
+    
+    return ES_OK;
+}
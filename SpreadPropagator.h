@@ -26,47 +26,52 @@
  * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
 
+
 #pragma once
-#ifndef __ROADEF_PROCESSPROPAGATOR_H__
-#define __ROADEF_PROCESSPROPAGATOR_H__
+#ifndef __ROADEF_SPREADPROPAGATOR_H__
+#define __ROADEF_SPREADPROPAGATOR_H__
+
+#include <vector>
 
 #include <gecode/int.hh>
 #include "Instance.h"
 #include "RescheduleSpace.h"
 
 /**
- * Adjust cost and balance variables and space delta.
+ * Enforce the minimum spread of a service whose staying processes do not
+ * cover enough locations on their own.
  */
-class ProcessPropagator : public Gecode::Propagator
+class SpreadPropagator : public Gecode::Propagator
 {
 protected:
-    /** Index of variables associated with considered process */
-    unsigned int m_index;
-    /** Id of the considered process */
-    unsigned int m_process;
-    /** Machine the process is assigned to */
-    Gecode::Int::IntView m_machine;
+    /** Machines of the unassigned moved processes of the service */
+    Gecode::ViewArray<Gecode::Int::IntView> m_machine;
+    /** Locations covered by staying and assigned moved processes */
+    unsigned int* m_location;
+    /** Number of entries used in m_location */
+    unsigned int m_covered;
+    /** Minimum number of distinct locations */
+    unsigned int m_min_spread;
     
-    int propagateLoad (RescheduleSpace& space, unsigned int machine_id, MachinePatch& patch);
-    int propagateBalance (RescheduleSpace& space, unsigned int machine_id, MachinePatch& patch);
+    /** Check whether the given location is already covered */
+    bool covers (unsigned int location) const;
     
 public:
     /** Initializing constructor */
-    ProcessPropagator (Gecode::Home home, unsigned int index, unsigned int process, Gecode::IntVar& machine);
+    SpreadPropagator (Gecode::Home home, Gecode::ViewArray<Gecode::Int::IntView>& machine, const std::vector<unsigned int>& locations, unsigned int min_spread);
     /** Copy constructor for Gecode search */
-    ProcessPropagator (Gecode::Home home, bool share, ProcessPropagator& p);
+    SpreadPropagator (Gecode::Home home, bool share, SpreadPropagator& p);
     
     /** Propagator copying for Gecode search */
-    virtual ProcessPropagator* copy (Gecode::Space& home, bool share);
+    virtual SpreadPropagator* copy (Gecode::Space& home, bool share);
     /** Propagator destruction for Gecode search */
     virtual size_t dispose (Gecode::Space& home);
-    /** Just return constant execution cost */
+    /** Linear in the number of unassigned moved processes */
     virtual Gecode::PropCost cost (const Gecode::Space& home, const Gecode::ModEventDelta& delta) const;
     /** Propagate */
     virtual Gecode::ExecStatus propagate (Gecode::Space& home, const Gecode::ModEventDelta& delta);
-    /** Setup method */
-    static Gecode::ExecStatus post (Gecode::Home home, unsigned int index, unsigned int process);
+    /** Setup method, @c index holds the moved indices of the service's processes, @c locations the distinct locations of its staying processes */
+    static Gecode::ExecStatus post (Gecode::Home home, const std::vector<unsigned int>& index, const std::vector<unsigned int>& locations, unsigned int min_spread);
 };
 
-
-#endif /* __ROADEF_PROCESSPROPAGATOR_H__ */
+#endif /* __ROADEF_SPREADPROPAGATOR_H__ */
@@ -1,48 +1,56 @@
-/*
- * Authors: 
- *   Felix Brandt <brandt@fzi.de>, 
- *   Jochen Speck <speck@kit.edu>, 
- *   Markus Voelker <markus.voelker@kit.edu>
- *
- * Copyright (c) 2012 Felix Brandt, Jochen Speck, Markus Voelker
- *
- * Permission is hereby granted, free of charge, to any person obtaining 
- * a copy of this software and associated documentation files (the 
- * "Software"), to deal in the Software without restriction, including 
- * without limitation the rights to use, copy, modify, merge, publish, 
- * distribute, sublicense, and/or sell copies of the Software, and to 
- * permit persons to whom the Software is furnished to do so, subject to 
- * the following conditions:
- *
- * The above copyright notice and this permission notice shall be included 
- * in all copies or substantial portions of the Software.
- *
- * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
- * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
- * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
- * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
- * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
- * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
- * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
- */
-
-#pragma once
-#ifndef __ROADEF_TARGETMOVESEARCH_H__
-#define __ROADEF_TARGETMOVESEARCH_H__
-
-#include "IterativeSearch.h"
-
-/**
- * Find most expensive process and move it cheaper machines.
- * Free all jobs on these machines and try to find a new valid solution.
- */
-class TargetMoveSearch : public IterativeSearch
-{
-public:
-    TargetMoveSearch(int identifier, time_t start_time);
-    virtual ~TargetMoveSearch();
-    
-    virtual ReAssignment* runOnce(const ReAssignment* current_state);
-};
-
-#endif /* __ROADEF_TARGETMOVESEARCH_H__ */
+/*
+ * Authors: 
+ *   Felix Brandt <brandt@fzi.de>, 
+ *   Jochen Speck <speck@kit.edu>, 
+ *   Markus Voelker <markus.voelker@kit.edu>
+ *
+ * Copyright (c) 2012 Felix Brandt, Jochen Speck, Markus Voelker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining 
+ * a copy of this software and associated documentation files (the 
+ * "Software"), to deal in the Software without restriction, including 
+ * without limitation the rights to use, copy, modify, merge, publish, 
+ * distribute, sublicense, and/or sell copies of the Software, and to 
+ * permit persons to whom the Software is furnished to do so, subject to 
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included 
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#ifndef __ROADEF_TARGETMOVESEARCH_H__
+#define __ROADEF_TARGETMOVESEARCH_H__
+
+#include "IterativeSearch.h"
+#include "MachineSlackIndex.h"
+#include "ProcessCostIndex.h"
+
+/**
+ * Find most expensive process and move it cheaper machines.
+ * Free all jobs on these machines and try to find a new valid solution.
+ */
+class TargetMoveSearch : public IterativeSearch
+{
+protected:
+    /** Machines ordered by total excess to enumerate the targets */
+    MachineSlackIndex slack;
+    /** Load cost reduction bounds of all processes, without the move costs counted by the shared index */
+    ProcessCostIndex load_costs;
+    
+public:
+    TargetMoveSearch(int identifier, time_t start_time);
+    virtual ~TargetMoveSearch();
+    
+    virtual ReAssignment* runOnce(const ReAssignment* current_state);
+};
+
+#endif /* __ROADEF_TARGETMOVESEARCH_H__ */
@@ -0,0 +1,76 @@
+/*
+ * Authors: 
+ *   Felix Brandt <brandt@fzi.de>, 
+ *   Jochen Speck <speck@kit.edu>, 
+ *   Markus Voelker <markus.voelker@kit.edu>
+ *
+ * Copyright (c) 2012 Felix Brandt, Jochen Speck, Markus Voelker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining 
+ * a copy of this software and associated documentation files (the 
+ * "Software"), to deal in the Software without restriction, including 
+ * without limitation the rights to use, copy, modify, merge, publish, 
+ * distribute, sublicense, and/or sell copies of the Software, and to 
+ * permit persons to whom the Software is furnished to do so, subject to 
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included 
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "TaskDeque.h"
+
+TaskDeque::TaskDeque ()
+{
+    pthread_mutex_init(&mutex, NULL);
+}
+
+TaskDeque::~TaskDeque ()
+{
+    pthread_mutex_destroy(&mutex);
+}
+
+void TaskDeque::push (const NeighborhoodTask& task)
+{
+    pthread_mutex_lock(&mutex);
+    tasks.push_back(task);
+    pthread_mutex_unlock(&mutex);
+}
+
+bool TaskDeque::pop (NeighborhoodTask& task)
+{
+    pthread_mutex_lock(&mutex);
+    while (!tasks.empty() && tasks.back().deadline.expired()) {
+        tasks.pop_back();
+    }
+    bool found = !tasks.empty();
+    if (found) {
+        task = tasks.back();
+        tasks.pop_back();
+    }
+    pthread_mutex_unlock(&mutex);
+    return found;
+}
+
+bool TaskDeque::steal (NeighborhoodTask& task)
+{
+    pthread_mutex_lock(&mutex);
+    while (!tasks.empty() && tasks.front().deadline.expired()) {
+        tasks.pop_front();
+    }
+    bool found = !tasks.empty();
+    if (found) {
+        task = tasks.front();
+        tasks.pop_front();
+    }
+    pthread_mutex_unlock(&mutex);
+    return found;
+}
@@ -0,0 +1,69 @@
+/*
+ * Authors: 
+ *   Felix Brandt <brandt@fzi.de>, 
+ *   Jochen Speck <speck@kit.edu>, 
+ *   Markus Voelker <markus.voelker@kit.edu>
+ *
+ * Copyright (c) 2012 Felix Brandt, Jochen Speck, Markus Voelker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining 
+ * a copy of this software and associated documentation files (the 
+ * "Software"), to deal in the Software without restriction, including 
+ * without limitation the rights to use, copy, modify, merge, publish, 
+ * distribute, sublicense, and/or sell copies of the Software, and to 
+ * permit persons to whom the Software is furnished to do so, subject to 
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included 
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#ifndef __ROADEF_TASKDEQUE_H__
+#define __ROADEF_TASKDEQUE_H__
+
+#include <deque>
+
+#include <pthread.h>
+
+#include "Instance.h"
+#include "TimeBudget.h"
+
+/** Neighborhood any worker can reschedule on its solution until the run that queued it ends */
+struct NeighborhoodTask
+{
+    ProcessList processes;
+    TimeBudget deadline;
+};
+
+/**
+ * Neighborhood tasks queued by one worker thread. The owner takes tasks from
+ * the back, idle workers steal from the front. Tasks whose deadline passed
+ * are dropped when they are dequeued.
+ */
+class TaskDeque
+{
+protected:
+    pthread_mutex_t mutex;
+    std::deque<NeighborhoodTask> tasks;
+    
+public:
+    TaskDeque ();
+    ~TaskDeque ();
+    
+    void push (const NeighborhoodTask& task);
+    /** Take the newest task, false if there is none */
+    bool pop (NeighborhoodTask& task);
+    /** Take the oldest task, false if there is none */
+    bool steal (NeighborhoodTask& task);
+};
+
+#endif /* __ROADEF_TASKDEQUE_H__ */
@@ -0,0 +1,60 @@
+/*
+ * Authors: 
+ *   Felix Brandt <brandt@fzi.de>, 
+ *   Jochen Speck <speck@kit.edu>, 
+ *   Markus Voelker <markus.voelker@kit.edu>
+ *
+ * Copyright (c) 2012 Felix Brandt, Jochen Speck, Markus Voelker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining 
+ * a copy of this software and associated documentation files (the 
+ * "Software"), to deal in the Software without restriction, including 
+ * without limitation the rights to use, copy, modify, merge, publish, 
+ * distribute, sublicense, and/or sell copies of the Software, and to 
+ * permit persons to whom the Software is furnished to do so, subject to 
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included 
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#ifndef __ROADEF_TIMEBUDGET_H__
+#define __ROADEF_TIMEBUDGET_H__
+
+/**
+ * Deadline on the monotonic clock with sub-second resolution. Unlike
+ * time(NULL) it does not jump with the system time, and slices of a few
+ * milliseconds end when they should.
+ */
+class TimeBudget
+{
+protected:
+    /** Monotonic time in seconds at which the budget is used up */
+    double deadline;
+    
+public:
+    /** Budget of the given number of seconds from now */
+    TimeBudget (double seconds = 0);
+    
+    /** Current monotonic time in seconds */
+    static double now ();
+    /** Budget ending at the given monotonic time */
+    static TimeBudget until (double deadline);
+    
+    /** Budget ending after the given number of seconds, but not after this one */
+    TimeBudget slice (double seconds) const;
+    double getDeadline () const { return deadline; }
+    double remaining () const;
+    bool expired () const;
+};
+
+#endif /* __ROADEF_TIMEBUDGET_H__ */
@@ -0,0 +1,178 @@
+/*
+ * Authors: 
+ *   Felix Brandt <brandt@fzi.de>, 
+ *   Jochen Speck <speck@kit.edu>, 
+ *   Markus Voelker <markus.voelker@kit.edu>
+ *
+ * Copyright (c) 2012 Felix Brandt, Jochen Speck, Markus Voelker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining 
+ * a copy of this software and associated documentation files (the 
+ * "Software"), to deal in the Software without restriction, including 
+ * without limitation the rights to use, copy, modify, merge, publish, 
+ * distribute, sublicense, and/or sell copies of the Software, and to 
+ * permit persons to whom the Software is furnished to do so, subject to 
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included 
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <algorithm>
+
+#include "TrailSearch.h"
+
+TrailSearch::TrailSearch () :
+limit(0), fixed_machine(-1), fail_limit(0), failures(0)
+{ }
+
+ReAssignment* TrailSearch::search (const ReAssignment& state, const ProcessList& moved, unsigned int _fail_limit, int fixed_index, int machine, const std::vector<ProcessList>* domains)
+{
+    const Instance& instance = *state.instance;
+    
+    trail.reset(state);
+    limit = trail.getCost();
+    fail_limit = _fail_limit;
+    failures = 0;
+    fixed_machine = fixed_index >= 0 ? machine : -1;
+    
+    // restricted process first, then the biggest processes as they are the hardest to place
+    std::vector<ProcessCost> size;
+    for (unsigned int i = 0; i < moved.size(); ++i) {
+        if ((int)i == fixed_index) {
+            continue;
+        }
+        
+        long long demand = 0;
+        for (unsigned int r = 0; r < (unsigned int)instance.num_resources; ++r) {
+            demand += instance.process[moved[i]].requirement[r];
+        }
+        size.push_back(ProcessCost(i, demand));
+    }
+    std::stable_sort(size.begin(), size.end());
+    
+    order.clear();
+    domain.clear();
+    if (fixed_index >= 0) {
+        order.push_back(moved[fixed_index]);
+        domain.push_back(NULL);
+    }
+    for (std::vector<ProcessCost>::const_iterator p = size.begin(); p != size.end(); ++p) {
+        order.push_back(moved[p->index]);
+        domain.push_back(domains ? &((*domains)[p->index]) : NULL);
+    }
+    
+    // placing a process adds at least its balance gain, load and move costs never decrease
+    bound.assign(order.size() + 1, 0);
+    for (int i = (int)order.size() - 1; i >= 0; --i) {
+        const Process& process = instance.process[order[i]];
+        long long gain = 0;
+        
+        for (unsigned int b = 0; b < instance.balance.size(); ++b) {
+            const Balance& bal = instance.balance[b];
+            int process_balance = process.requirement[bal.resource2] - bal.balance * process.requirement[bal.resource1];
+            gain += std::min(0, process_balance) * (long long)bal.weight_balance_cost;
+        }
+        
+        bound[i] = bound[i + 1] + gain;
+    }
+    
+    if (candidates.size() < order.size()) {
+        candidates.resize(order.size());
+    }
+    
+    for (ProcessList::const_iterator p = order.begin(); p != order.end(); ++p) {
+        trail.lift(*p);
+    }
+    
+    ReAssignment* result = NULL;
+    if (trail.getCost() + bound[0] < limit && branch(0)) {
+        result = trail.getResultState();
+    }
+    
+    return result;
+}
+
+bool TrailSearch::branch (unsigned int depth)
+{
+    if (depth == order.size()) {
+        if (trail.getCost() < limit && trail.valid()) {
+            return true;
+        }
+        failures++;
+        return false;
+    }
+    
+    const Instance& instance = trail.getInstance();
+    unsigned int p = order[depth];
+    
+    // machines blocked by other processes of the same service
+    std::vector<unsigned int> blocked;
+    const ProcessList& members = instance.service[instance.process[p].service].process;
+    for (ProcessList::const_iterator q = members.begin(); q != members.end(); ++q) {
+        int m = trail.getMachine(*q);
+        if (m >= 0) {
+            blocked.push_back(m);
+        }
+    }
+    std::sort(blocked.begin(), blocked.end());
+    
+    unsigned int first = 0;
+    unsigned int last = domain[depth] ? domain[depth]->size() : instance.num_machines;
+    if (depth == 0 && fixed_machine >= 0) {
+        first = fixed_machine;
+        last = fixed_machine + 1;
+    }
+    
+    std::vector<std::pair<long long, unsigned int> >& candidate = candidates[depth];
+    candidate.clear();
+    
+    long long base = trail.getCost() + bound[depth + 1];
+    for (unsigned int i = first; i < last; ++i) {
+        unsigned int m = domain[depth] ? (*domain[depth])[i] : i;
+        if (std::binary_search(blocked.begin(), blocked.end(), m) || !trail.fits(p, m)) {
+            continue;
+        }
+        
+        long long delta = trail.getDelta(p, m);
+        if (base + delta >= limit || !trail.spreads(p, m)) {
+            continue;
+        }
+        
+        candidate.push_back(std::pair<long long, unsigned int>(delta, m));
+    }
+    
+    if (candidate.empty()) {
+        failures++;
+        return false;
+    }
+    
+    // cheapest machine first
+    std::sort(candidate.begin(), candidate.end());
+    
+    for (unsigned int c = 0; c < candidate.size() && failures < fail_limit; ++c) {
+        size_t mark = trail.mark();
+        trail.place(p, candidate[c].second);
+        
+        if (branch(depth + 1)) {
+            return true;
+        }
+        
+        trail.undo(mark);
+    }
+    
+    return false;
+}
+
+bool TrailSearch::stopped () const
+{
+    return failures >= fail_limit;
+}
@@ -0,0 +1,83 @@
+/*
+ * Authors: 
+ *   Felix Brandt <brandt@fzi.de>, 
+ *   Jochen Speck <speck@kit.edu>, 
+ *   Markus Voelker <markus.voelker@kit.edu>
+ *
+ * Copyright (c) 2012 Felix Brandt, Jochen Speck, Markus Voelker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining 
+ * a copy of this software and associated documentation files (the 
+ * "Software"), to deal in the Software without restriction, including 
+ * without limitation the rights to use, copy, modify, merge, publish, 
+ * distribute, sublicense, and/or sell copies of the Software, and to 
+ * permit persons to whom the Software is furnished to do so, subject to 
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included 
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#ifndef __ROADEF_TRAILSEARCH_H__
+#define __ROADEF_TRAILSEARCH_H__
+
+#include <vector>
+
+#include "Instance.h"
+#include "AssignmentTrail.h"
+
+/**
+ * Depth-first branch and bound over a small neighborhood without Gecode.
+ * Lifted processes are placed one at a time on an AssignmentTrail and taken
+ * back by undoing the trail, so no state is copied during search.
+ * Like the DFS on a RescheduleSpace it returns the first improving solution.
+ */
+class TrailSearch
+{
+protected:
+    AssignmentTrail trail;
+    
+    /** Lifted processes in branching order */
+    ProcessList order;
+    /** Allowed machines per process in branching order, NULL for all machines */
+    std::vector<const ProcessList*> domain;
+    /** Lower bound on the cost change of placing the processes from a depth on */
+    std::vector<long long> bound;
+    /** Cost of the state, solutions have to be cheaper */
+    long long limit;
+    
+    /** Machine the first process in order is restricted to, -1 if none */
+    int fixed_machine;
+    /** Candidate machines and cost changes per depth, kept to avoid reallocation */
+    std::vector<std::vector<std::pair<long long, unsigned int> > > candidates;
+    
+    unsigned int fail_limit;
+    unsigned int failures;
+    
+    /** Place the process at the given depth and recurse, true if a solution was found */
+    bool branch (unsigned int depth);
+    
+public:
+    TrailSearch ();
+    
+    /**
+     * Search for a cheaper assignment of the moved processes, the process at
+     * @c fixed_index (if any) has to go to @c machine. If @c domains is
+     * given, the moved processes are restricted to these machines.
+     * Returns NULL if none is found within @c fail_limit failures.
+     */
+    ReAssignment* search (const ReAssignment& state, const ProcessList& moved, unsigned int fail_limit, int fixed_index = -1, int machine = -1, const std::vector<ProcessList>* domains = NULL);
+    /** Whether the last search ended at the fail limit */
+    bool stopped () const;
+};
+
+#endif /* __ROADEF_TRAILSEARCH_H__ */
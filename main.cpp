@@ -1,397 +1,666 @@
-/*
- * Authors: 
- *   Felix Brandt <brandt@fzi.de>, 
- *   Jochen Speck <speck@kit.edu>, 
- *   Markus Voelker <markus.voelker@kit.edu>
- *
- * Copyright (c) 2012 Felix Brandt, Jochen Speck, Markus Voelker
- *
- * Permission is hereby granted, free of charge, to any person obtaining 
- * a copy of this software and associated documentation files (the 
- * "Software"), to deal in the Software without restriction, including 
- * without limitation the rights to use, copy, modify, merge, publish, 
- * distribute, sublicense, and/or sell copies of the Software, and to 
- * permit persons to whom the Software is furnished to do so, subject to 
- * the following conditions:
- *
- * The above copyright notice and this permission notice shall be included 
- * in all copies or substantial portions of the Software.
- *
- * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
- * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
- * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
- * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
- * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
- * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
- * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
- */
-
-#include <fstream>
-#include <time.h>
-
-#include <gecode/gist.hh>
-
-#include <pthread.h>
-
-#include "Instance.h"
-#include "RescheduleSpace.h"
-#include "RandomSearch.h"
-#include "TargetMoveSearch.h"
-#include "UndoMoveSearch.h"
-#include "ProcessNeighborhoodSearch.h"
-#include "SchedulePlotter.h"
-#include "ProcessFixing.h"
-
-using namespace std;
-
-// lock for exclusive access to global_best
-pthread_mutex_t mutex1 = PTHREAD_MUTEX_INITIALIZER; 
-
-// global optimal solution
-ReAssignment* global_best;
-
-int write_counter;
-
-void print (char* file, ReAssignment* best = NULL)
-{
-    std::ostream* out = &std::cout;
-    std::ofstream fout;
-    
-    if (file != NULL) {
-        fout.open(file);
-        if (fout.good()) {
-            out = &fout;
-        }
-    }
-    
-    if (best) {
-        std::copy(best->assignment.begin(), best->assignment.end(), std::ostream_iterator<int>(*out, " "));
-        (*out) << std::endl;
-    } else {
-        (*out) << "no solution found" << std::endl;
-    }
-    
-    if (file != NULL) {
-        fout.close();
-    }
-}
-
-struct SearchEntry {
-public:
-    SearchEntry(string _label, BaseSearch* _search, int _start_time, int _end_time, int _duration) : label(_label), search(_search), start_time(_start_time), end_time(_end_time), duration(_duration), active(true) {};
-    
-    string label;
-    BaseSearch* search;
-    int start_time; // time after which search is started
-    int end_time; // time after which search is ended
-    int duration; // duration of one run
-    bool active; // flag to enable/disable the search strategy
-};
-
-struct threadworkdata{
-    vector<SearchEntry>* searches;
-    ReAssignment* best;
-    time_t deadline;
-    Instance* instancep;
-    time_t start;
-    char* solution_file;
-    bool manage_process_fixing;
-};
-
-// thread function
-void * threadwork(void* datav)
-{
-    threadworkdata data = *((threadworkdata*) datav);
-    ProcessFixing process_fixing(*(data.instancep));
-    if (data.manage_process_fixing)
-    	process_fixing.fixTransient(data.instancep->num_processes > 3000 ? 0.9 : 0.8);
-    ReAssignment* new_best = NULL;
-    
-    while (time(NULL) < data.deadline) {
-        // rotate through searches
-        for (int i = 0; i < data.searches->size(); i++) {
-            SearchEntry& se = (*(data.searches))[i];
-            
-            time_t cur_time = time(NULL);
-            if (cur_time >= data.deadline)
-                break;
-            
-            // skip search if not active or not within time constraints
-            if (!se.active || cur_time-data.start < se.start_time || (se.end_time >= 0 && cur_time-data.start > se.end_time))
-                continue;
-            
-            #ifdef LOGGING
-            std::cerr << cur_time-data.start << ": Starting " << se.label << endl;
-            #endif
-            
-            // check whether better solution exists
-            pthread_mutex_lock(&mutex1);
-            if (data.best->getCost() > global_best->getCost())
-            {
-                delete data.best;
-                data.best = new ReAssignment(*global_best);
-            }
-            pthread_mutex_unlock(&mutex1);
-            
-            // run search
-            new_best = se.search->run(data.best, std::min(time(NULL) + se.duration, data.deadline));
-            
-            if (new_best) {
-                // synchronisation
-                pthread_mutex_lock(&mutex1);
-                if(new_best->getCost() < global_best->getCost())
-                {
-                    // we found a better solution
-                    delete global_best;
-                    global_best = new ReAssignment(*new_best);
-                    write_counter++;
-                    if(write_counter > 4)
-                    {
-                        // write solution to file
-                        #ifdef LOGGING
-                        std::cerr << "Result: " << global_best->load_cost << " " << global_best->balance_cost << " " << global_best->process_moves << " " << global_best->machine_moves << std::endl;
-                        #endif
-                        print(data.solution_file, global_best);
-                        write_counter = 0;
-                    }
-                }
-                pthread_mutex_unlock( &mutex1 );
-                delete data.best;
-                data.best = new_best;
-            }
-            
-            // release fixed processes after 45 seconds
-            if (data.manage_process_fixing && cur_time-data.start >= 45) {
-                data.manage_process_fixing = false;
-                process_fixing.reset();
-            }
-        }
-    }
-}
-
-/**
- * Run solver if all parameters are present.
- * Otherwise print usage information to stderr
- */
-int main (int args, char** argv)
-{
-    time_t start = time(NULL);
-    time_t time_limit = -1;
-    int seed = -1;
-    int neighbor = -1;
-    
-    char* model = NULL; // the machine model file
-    char* initial = NULL; // initial solution file
-    char* current = NULL; // current solution file
-    char* solution_file = NULL; // best solution of this run file
-    
-    bool chart = false;
-    bool depgraph = false;
-    
-    for (int a = 1; a < args; ++a)
-    {
-        if (argv[a][0] == '-')
-        {
-            // its a parameter
-            switch (argv[a][1])
-            {
-                case 't': // time limit
-                    time_limit = atoi(argv[++a]);
-                    break;
-                case 'p': // problem instance
-                    model = argv[++a];
-                    break;
-                case 'i': // initial solution
-                    initial = argv[++a];
-                    break;
-                case 'j': // current solution
-                    current = argv[++a];
-                    break;
-                case 'c': // make plot of solution
-                    chart = true;
-                    break;
-                case 'd': // make service dependency graph
-                    depgraph = true;
-                    break;
-                case 'r': // random search, size of the neighborhood
-                    neighbor = atoi(argv[++a]);
-                    break;
-                case 'o': // result file
-                    solution_file = argv[++a];
-                    break;
-                case 'n': // team name
-                    std::cout << "J25" << std::endl;
-                    return 0;
-                    break;
-                case 's': // seed
-                    seed = atoi(argv[++a]);
-                    srand(seed);
-                    #ifdef LOGGING
-                    std::cerr << "Init rand() first number generated: " << rand() << std::endl;
-                    #endif
-                    break;
-                default:  // unknown parameter -> quit
-                    std::cerr << "Unknown parameter: " << argv[a] << std::endl;
-                    return 1;
-            }
-        }
-    }
-    
-    time_t firstdeadline = start + (time_limit/2);
-    time_t deadline = start + time_limit - 1; // one second buffer time
-    
-    if (model == NULL)
-    {
-        std::cerr << "Model file not given" << std::endl;
-        return 1;
-    }
-    
-    ifstream model_file(model);
-    if (!model_file.good())
-    {
-        std::cerr << "Could not open model file" << std::endl;
-        return 1;
-    }
-    
-    if (initial == NULL)
-    {
-        std::cerr << "Assignment file not given" << std::endl;
-        return 1;
-    }
-    
-    ifstream assignment_file(initial);
-    if (!assignment_file.good())
-    {
-        std::cerr << "Could not open assignment file" << std::endl;
-        return 1;
-    }
-    
-    #ifdef LOGGING
-    std::cerr << "reading instance " << model_file << " ... ";
-    #endif
-    
-    Instance instance(model_file);
-    Assignment initial_state;
-    std::copy(istream_iterator<int>(assignment_file), istream_iterator<int>(), back_inserter(initial_state));
-    for (int p = 0; p < instance.num_processes; p++)
-        instance.process[p].original_machine = initial_state[p];
-    
-    #ifdef LOGGING
-    std::cerr << "done" << std::endl;
-    #endif
-    
-    ostream* out = &std::cout;
-    
-    model_file.close();
-    assignment_file.close();
-    
-    if (chart)
-    {
-        Assignment current_state(initial_state);
-        if (current != NULL) {
-            ifstream current_file(current);
-            std::copy(istream_iterator<int>(current_file), istream_iterator<int>(), current_state.begin());
-        }
-        
-        SchedulePlotter::plot(*out, instance, initial_state, current_state);
-    }
-    else if (depgraph)
-    {
-        std::cout << "digraph {" << std::endl;
-        for (unsigned int s = 0; s < instance.service.size(); ++s)
-        {
-            for (unsigned int d = 0; d < instance.service[s].depends_on.size(); ++d)
-            {
-                std::cout << s << " -> " << instance.service[s].depends_on[d] << ";" << std::endl;
-            }
-        }
-        std::cout << "graph [ file = \"" << model << "\" ]" << std::endl << "}" << std::endl;
-    }
-    else
-    {
-        #ifdef LOGGING
-        std::cerr << "Setup space ... ";
-        #endif
-        
-        // thread data
-        threadworkdata *data1 = (threadworkdata*)malloc(sizeof(threadworkdata));
-        threadworkdata *data2 = (threadworkdata*)malloc(sizeof(threadworkdata));
-        
-        ReAssignment initial_solution;
-        instance.reorderResources();
-        instance.setAssignment(initial_state, &initial_solution);
-        
-        data1->instancep = &instance;
-        data2->instancep = &instance;
-        data1->start = start;
-        data1->deadline = deadline;
-        data2->start = start;
-        data2->deadline = deadline;
-        data1->solution_file = solution_file;
-        data2->solution_file = solution_file;
-        data1->manage_process_fixing = true;
-        data2->manage_process_fixing = false;
-        
-        data1->best = new ReAssignment;
-        data2->best = new ReAssignment;
-        global_best = new ReAssignment;
-        
-        instance.setAssignment(initial_state, data1->best);
-        instance.setAssignment(initial_state, data2->best);
-        instance.setAssignment(initial_state, global_best);
-        write_counter = 0;
-        
-        TargetMoveSearch tms1(11, start);
-        TargetMoveSearch tms2(12, start);
-        ProcessNeighborhoodSearch pns1(21, start);
-        ProcessNeighborhoodSearch pns2(22, start);
-        RandomSearch rs1(31, start, 7);
-        RandomSearch rs2(32, start, 9);
-        UndoMoveSearch ums1(41, start);
-        UndoMoveSearch ums2(42, start);
-        
-        data1->searches = new vector<SearchEntry>;
-        data2->searches = new vector<SearchEntry>;
-        
-        data1->searches->push_back(SearchEntry("P1: 11 TMS", &tms1, 0, 45, 5)); // earliest start: 0, latest start: 45, duration: 5 seconds
-        data1->searches->push_back(SearchEntry("P1: 21 PNS", &pns1, 0, -1, 4)); // earliest start: 0, latest start: -, duration: 4 seconds
-        data1->searches->push_back(SearchEntry("P1: 31 RS7", &rs1, 60, -1, 4)); // earliest start: 60, latest start: -, duration: 4 seconds
-        data1->searches->push_back(SearchEntry("P1: 41 UMS", &ums1, 0, -1, 1)); // earliest start: 0, latest start: -, duration: 1 seconds
-        
-        data2->searches->push_back(SearchEntry("P2: 22 PNS", &pns2, 0, -1, 5)); // earliest start: 0, latest start: -, duration: 5 seconds
-        data2->searches->push_back(SearchEntry("P2: 12 TMS", &tms2, 0, 60, 5)); // earliest start: 0, latest start: 60, duration: 5 seconds
-        data2->searches->push_back(SearchEntry("P2: 42 UMS", &ums2, 0, -1, 1)); // earliest start: 0, latest start: -, duration: 1 seconds
-        data2->searches->push_back(SearchEntry("P2: 32 RS9", &rs2, 60, -1, 4)); // earliest start: 60, latest start: -, duration: 4 seconds
-        
-        pthread_t* iThreadIds = new pthread_t[2];
-        
-        int rv = pthread_create(&iThreadIds[0], NULL, &threadwork, data1);
-        
-        #ifdef LOGGING
-        if (rv < 0) printf("error creating thread.\n");
-        #endif
-        
-        rv = pthread_create(&iThreadIds[1], NULL, &threadwork, data2);
-        
-        #ifdef LOGGING
-        if (rv < 0) printf("error creating thread.\n");
-        #endif
-        
-        int i, status;
-        for (i = 0; i < 2; i++) {
-            status = pthread_join(iThreadIds[i],NULL);
-            #ifdef LOGGING
-            if (status != 0) printf("error in thread %d with id %d\n", i, (int)iThreadIds[i]);
-            else printf(" thread %d with id %d stopped without errors\n", i, (int)iThreadIds[i]);
-            #endif
-        }
-        
-        // write final solution to file
-        std::cerr << "Final result: " << global_best->load_cost << " " << global_best->balance_cost << " " << global_best->process_moves << " " << global_best->machine_moves << std::endl;
-        print(solution_file, global_best);
-        delete global_best;
-        
-    }
-    
-    return 0;
-}
+/*
+ * Authors: 
+ *   Felix Brandt <brandt@fzi.de>, 
+ *   Jochen Speck <speck@kit.edu>, 
+ *   Markus Voelker <markus.voelker@kit.edu>
+ *
+ * Copyright (c) 2012 Felix Brandt, Jochen Speck, Markus Voelker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining 
+ * a copy of this software and associated documentation files (the 
+ * "Software"), to deal in the Software without restriction, including 
+ * without limitation the rights to use, copy, modify, merge, publish, 
+ * distribute, sublicense, and/or sell copies of the Software, and to 
+ * permit persons to whom the Software is furnished to do so, subject to 
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included 
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <fstream>
+#include <sstream>
+#include <time.h>
+
+#include <gecode/gist.hh>
+
+#include <pthread.h>
+#include <unistd.h>
+
+#include "Instance.h"
+#include "RescheduleSpace.h"
+#include "RandomSearch.h"
+#include "TargetMoveSearch.h"
+#include "UndoMoveSearch.h"
+#include "ExchangeSearch.h"
+#include "ShiftSwapSearch.h"
+#include "ProcessNeighborhoodSearch.h"
+#include "PipelineSearch.h"
+#include "RegionSearch.h"
+#include "BatchSearch.h"
+#include "SchedulePlotter.h"
+#include "ProcessFixing.h"
+#include "AdaptiveScheduler.h"
+#include "TaskDeque.h"
+#include "Incumbent.h"
+#include "MoveMerger.h"
+
+using namespace std;
+
+// lock for writing the solution file
+pthread_mutex_t mutex1 = PTHREAD_MUTEX_INITIALIZER; 
+
+// global optimal solution
+Incumbent* global_best;
+
+int write_counter;
+
+void print (char* file, ReAssignment* best = NULL)
+{
+    std::ostream* out = &std::cout;
+    std::ofstream fout;
+    
+    if (file != NULL) {
+        fout.open(file);
+        if (fout.good()) {
+            out = &fout;
+        }
+    }
+    
+    if (best) {
+        std::copy(best->assignment.begin(), best->assignment.end(), std::ostream_iterator<int>(*out, " "));
+        (*out) << std::endl;
+    } else {
+        (*out) << "no solution found" << std::endl;
+    }
+    
+    if (file != NULL) {
+        fout.close();
+    }
+}
+
+/**
+ * Run the same random neighborhoods through the Gecode and the trail engine
+ * and report the time spent and the improvements found by each
+ */
+void benchmark (const ReAssignment& state, int count, int size, unsigned int seed)
+{
+    const Instance& instance = *state.instance;
+    Random random(seed);
+    RandomSearch search(0, time(NULL), size);
+    search.setBudget(TimeBudget(3600)); // the engines only stop at their fail limits
+    unsigned int threshold = IterativeSearch::trail_threshold;
+    
+    clock_t elapsed[2] = { 0, 0 };
+    int improved[2] = { 0, 0 };
+    
+    for (int i = 0; i < count; ++i) {
+        ProcessList n(size);
+        for (int t = 0; t < size; ++t) {
+            n[t] = instance.processes_by_size[random(instance.num_processes)];
+        }
+        std::sort(n.begin(), n.end());
+        n.resize(unique(n.begin(), n.end()) - n.begin());
+        
+        for (int e = 0; e < 2; ++e) {
+            IterativeSearch::trail_threshold = (e == 0) ? 0 : n.size();
+            
+            clock_t begin = clock();
+            ReAssignment* result = search.reschedule(state, n);
+            elapsed[e] += clock() - begin;
+            
+            if (result) {
+                improved[e]++;
+                delete result;
+            }
+        }
+    }
+    
+    IterativeSearch::trail_threshold = threshold;
+    
+    std::cerr << "Gecode: " << 1000.0 * elapsed[0] / CLOCKS_PER_SEC << " ms, " << improved[0] << "/" << count << " improved" << std::endl;
+    std::cerr << "Trail:  " << 1000.0 * elapsed[1] / CLOCKS_PER_SEC << " ms, " << improved[1] << "/" << count << " improved" << std::endl;
+}
+
+struct threadworkdata{
+    int worker;
+    unsigned int seed; // master seed, the generators of the worker use streams derived from the worker id
+    AdaptiveScheduler* scheduler;
+    vector<BaseSearch*> searches; // strategy instances of this worker
+    BatchSearch* batch; // search queueing neighborhood tasks, also solves stolen ones
+    RegionSearch* region; // search of the region phases, NULL without them
+    vector<TaskDeque*>* queues; // neighborhood task deques of all workers
+    ReAssignment* best;
+    long long version; // incumbent version equal to best, -1 if it differs
+    TimeBudget deadline; // end of the run on the monotonic clock
+    const Instance* instancep; // model shared by all workers, only read
+    ProcessFixing* fixing; // processes this worker must not move
+    ProcessCostIndex* costs; // cost reductions of the processes, shared by the searches of this worker
+    time_t start;
+    double epoch; // monotonic time at the start, elapsed times are measured from it
+    char* solution_file;
+    bool manage_process_fixing;
+    unsigned int improvements; // number of global improvements found by this worker
+    long long gain; // cost reduction of these improvements
+    unsigned int stolen; // number of tasks taken from other workers
+};
+
+// number of different strategy lists
+const unsigned int num_profiles = 2;
+
+// length of the rounds alternating between region phases and normal
+// scheduling in seconds, 0 disables the region phases
+unsigned int region_period = 0;
+
+// helper threads of the pipeline search on the first worker, 0 disables it
+unsigned int pipeline_helpers = 0;
+
+/**
+ * Create the strategy instances of a worker, even and odd workers get the
+ * strategy lists of the former first and second thread
+ */
+void addSearches (threadworkdata& data)
+{
+    int w = data.worker;
+    time_t start = data.start;
+    ostringstream prefix;
+    prefix << "P" << w + 1 << ": ";
+    
+    BaseSearch* sss = new ShiftSwapSearch(60 + w + 1, start);
+    BaseSearch* tms = new TargetMoveSearch(10 + w + 1, start);
+    BaseSearch* pns = new ProcessNeighborhoodSearch(20 + w + 1, start);
+    BaseSearch* ums = new UndoMoveSearch(40 + w + 1, start);
+    
+    data.scheduler = new AdaptiveScheduler;
+    data.batch = new BatchSearch(90 + w + 1, start, 7, 8, (*data.queues)[w]);
+    
+    if (w % num_profiles == 0) {
+        BaseSearch* rs = new RandomSearch(30 + w + 1, start, 7);
+        BaseSearch* xs = new ExchangeSearch(50 + w + 1, start);
+        data.searches.push_back(sss);
+        data.searches.push_back(tms);
+        data.searches.push_back(pns);
+        data.searches.push_back(rs);
+        data.searches.push_back(ums);
+        data.searches.push_back(xs);
+        
+        data.scheduler->add(SearchEntry(prefix.str() + "SSS", sss, 0, -1, 2)); // earliest start: 0, latest start: -, initial duration: 2 seconds
+        data.scheduler->add(SearchEntry(prefix.str() + "TMS", tms, 0, 45, 5)); // earliest start: 0, latest start: 45, initial duration: 5 seconds
+        data.scheduler->add(SearchEntry(prefix.str() + "PNS", pns, 0, -1, 4)); // earliest start: 0, latest start: -, initial duration: 4 seconds
+        data.scheduler->add(SearchEntry(prefix.str() + "RS7", rs, 60, -1, 4)); // earliest start: 60, latest start: -, initial duration: 4 seconds
+        data.scheduler->add(SearchEntry(prefix.str() + "UMS", ums, 0, -1, 1)); // earliest start: 0, latest start: -, initial duration: 1 seconds
+        data.scheduler->add(SearchEntry(prefix.str() + "XS", xs, 0, -1, 1)); // earliest start: 0, latest start: -, initial duration: 1 seconds
+    } else {
+        BaseSearch* rs = new RandomSearch(30 + w + 1, start, 9);
+        data.searches.push_back(sss);
+        data.searches.push_back(pns);
+        data.searches.push_back(tms);
+        data.searches.push_back(ums);
+        data.searches.push_back(rs);
+        
+        data.scheduler->add(SearchEntry(prefix.str() + "SSS", sss, 0, -1, 2)); // earliest start: 0, latest start: -, initial duration: 2 seconds
+        data.scheduler->add(SearchEntry(prefix.str() + "PNS", pns, 0, -1, 5)); // earliest start: 0, latest start: -, initial duration: 5 seconds
+        data.scheduler->add(SearchEntry(prefix.str() + "TMS", tms, 0, 60, 5)); // earliest start: 0, latest start: 60, initial duration: 5 seconds
+        data.scheduler->add(SearchEntry(prefix.str() + "UMS", ums, 0, -1, 1)); // earliest start: 0, latest start: -, initial duration: 1 seconds
+        data.scheduler->add(SearchEntry(prefix.str() + "RS9", rs, 60, -1, 4)); // earliest start: 60, latest start: -, initial duration: 4 seconds
+    }
+    
+    // neighborhood batches other workers can help with
+    data.searches.push_back(data.batch);
+    data.scheduler->add(SearchEntry(prefix.str() + "NBS", data.batch, 60, -1, 2)); // earliest start: 60, latest start: -, initial duration: 2 seconds
+    
+    // the pipeline helpers take the place of other workers, so only one worker runs it
+    if (pipeline_helpers > 0 && w == 0) {
+        BaseSearch* pip = new PipelineSearch(70 + w + 1, start, pipeline_helpers, 16, 7);
+        data.searches.push_back(pip);
+        data.scheduler->add(SearchEntry(prefix.str() + "PIP", pip, 60, -1, 4)); // earliest start: 60, latest start: -, initial duration: 4 seconds
+    }
+    
+    // region phases are not scheduled, all workers enter them at the same time
+    data.region = NULL;
+    if (region_period > 0) {
+        data.region = new RegionSearch(80 + w + 1, start, w, data.queues->size(), 7, data.epoch, region_period);
+        data.searches.push_back(data.region);
+    }
+    
+    // searches give up their slice when another worker improves the incumbent,
+    // except for region runs: the other workers only commit moves on their own
+    // regions, the result is merged into their solution afterwards
+    for (unsigned int i = 0; i < data.searches.size(); ++i)
+        if (data.searches[i] != data.region)
+            data.searches[i]->setIncumbent(global_best);
+    
+    // fixed processes are kept per worker, the shared instance is never written
+    for (unsigned int i = 0; i < data.searches.size(); ++i)
+        data.searches[i]->setFixing(data.fixing);
+    
+    // one cost index per worker, it follows the moves of the worker's solutions
+    for (unsigned int i = 0; i < data.searches.size(); ++i)
+        data.searches[i]->setCosts(data.costs);
+    
+    // one generator per search and for the scheduler, so runs with the same seed draw the same numbers
+    data.scheduler->setSeed(data.seed, 100 * w);
+    for (unsigned int i = 0; i < data.searches.size(); ++i)
+        data.searches[i]->setSeed(data.seed, 100 * w + i + 1);
+}
+
+/**
+ * Whether the given number of seconds since the start falls into a region
+ * phase, in which every worker only searches its own region
+ */
+bool regionPhase (double elapsed)
+{
+    return region_period > 0 && (long long)(elapsed / region_period) % 2 == 0;
+}
+
+/**
+ * Time left for a run, no run crosses the border of a round so that the
+ * runs of a region phase never overlap with other searches
+ */
+TimeBudget phaseBudget (const threadworkdata& data, double elapsed)
+{
+    if (region_period == 0)
+        return data.deadline;
+    
+    double round_end = ((long long)(elapsed / region_period) + 1) * (double)region_period;
+    return data.deadline.slice(round_end - elapsed);
+}
+
+/**
+ * Take the oldest task of another worker
+ */
+bool stealTask (threadworkdata& data, NeighborhoodTask& task)
+{
+    vector<TaskDeque*>& queues = *data.queues;
+    for (unsigned int k = 1; k < queues.size(); ++k) {
+        unsigned int victim = (data.worker + k) % queues.size();
+        if (queues[victim]->steal(task))
+            return true;
+    }
+    return false;
+}
+
+// thread function
+void * threadwork(void* datav)
+{
+    threadworkdata& data = *((threadworkdata*) datav);
+    TaskDeque& queue = *(*data.queues)[data.worker];
+    MoveMerger merger;
+    if (data.manage_process_fixing)
+    	data.fixing->fixTransient(data.instancep->num_processes > 3000 ? 0.9 : 0.8);
+    ReAssignment* new_best = NULL;
+    
+    while (!data.deadline.expired()) {
+        double elapsed = TimeBudget::now() - data.epoch;
+        
+        // check whether better solution exists and catch up with it
+        if (data.best->getCost() > global_best->getCost())
+        {
+            global_best->refresh(data.best, data.version, data.worker);
+        }
+        
+        // in region phases all workers change disjoint machines, a region run
+        // is not interrupted by the others and a result that can not be
+        // published is merged into the incumbent.
+        // Otherwise help with queued neighborhoods first and then run the
+        // next search chosen by its past improvements.
+        TimeBudget budget = phaseBudget(data, elapsed);
+        long long base_version = data.version;
+        NeighborhoodTask task;
+        bool stolen = false;
+        if (regionPhase(elapsed)) {
+            new_best = data.region->run(data.best, budget);
+        } else if (queue.pop(task) || (stolen = stealTask(data, task))) {
+            data.stolen += stolen;
+            new_best = data.batch->solve(*data.best, task, budget);
+        } else {
+            int i = data.scheduler->select((int)elapsed);
+            if (i < 0)
+                break;
+            SearchEntry& se = data.scheduler->get(i);
+            
+            #ifdef LOGGING
+            std::cerr << elapsed << ": Starting " << se.label << " (score " << se.score << ", " << se.duration << "s)" << endl;
+            #endif
+            
+            // run search
+            long long cost = data.best->getCost();
+            double cpu_time = AdaptiveScheduler::getThreadTime();
+            new_best = se.search->run(data.best, budget.slice(se.duration));
+            data.scheduler->update(i, new_best ? cost - new_best->getCost() : 0, AdaptiveScheduler::getThreadTime() - cpu_time + se.search->getHelperTime());
+        }
+        
+        if (new_best) {
+            // synchronisation
+            long long previous = global_best->getCost();
+            bool published = global_best->publish(*new_best, data.worker, &data.version);
+            
+            if (!published)
+            {
+                // the incumbent moved on since the run started, carry our moves over to it
+                long long target_version;
+                ReAssignment* target = global_best->acquire(data.worker, &target_version);
+                if (base_version < 0 || target_version != base_version)
+                {
+                    ReAssignment* merged = merger.merge(*data.best, *new_best, *target);
+                    previous = target->getCost();
+                    
+                    if (merged && global_best->publish(*merged, data.worker, &data.version))
+                    {
+                        published = true;
+                        delete new_best;
+                        new_best = merged;
+                    }
+                    else
+                    {
+                        delete merged;
+                    }
+                }
+                delete target;
+            }
+            
+            if (published)
+            {
+                // we found a better solution
+                data.improvements++;
+                data.gain += previous - new_best->getCost();
+                
+                pthread_mutex_lock(&mutex1);
+                write_counter++;
+                if(write_counter > 4 && new_best->getCost() <= global_best->getCost())
+                {
+                    // write solution to file
+                    #ifdef LOGGING
+                    std::cerr << "Result: " << new_best->load_cost << " " << new_best->balance_cost << " " << new_best->process_moves << " " << new_best->machine_moves << std::endl;
+                    #endif
+                    print(data.solution_file, new_best);
+                    write_counter = 0;
+                }
+                pthread_mutex_unlock( &mutex1 );
+            }
+            else
+            {
+                // the local solution departs from the incumbent
+                data.version = -1;
+            }
+            delete data.best;
+            data.best = new_best;
+        }
+        
+        // release fixed processes after 45 seconds
+        if (data.manage_process_fixing && elapsed >= 45) {
+            data.manage_process_fixing = false;
+            data.fixing->reset();
+        }
+    }
+    
+    return NULL;
+}
+
+/**
+ * Run solver if all parameters are present.
+ * Otherwise print usage information to stderr
+ */
+int main (int args, char** argv)
+{
+    time_t start = time(NULL);
+    double epoch = TimeBudget::now();
+    time_t time_limit = -1;
+    unsigned int seed = 0;
+    int neighbor = -1;
+    
+    char* model = NULL; // the machine model file
+    char* initial = NULL; // initial solution file
+    char* current = NULL; // current solution file
+    char* solution_file = NULL; // best solution of this run file
+    
+    bool chart = false;
+    bool depgraph = false;
+    int bench = 0;
+    int threads = 2;
+    
+    for (int a = 1; a < args; ++a)
+    {
+        if (argv[a][0] == '-')
+        {
+            // its a parameter
+            switch (argv[a][1])
+            {
+                case 't': // time limit
+                    time_limit = atoi(argv[++a]);
+                    break;
+                case 'p': // problem instance
+                    model = argv[++a];
+                    break;
+                case 'i': // initial solution
+                    initial = argv[++a];
+                    break;
+                case 'j': // current solution
+                    current = argv[++a];
+                    break;
+                case 'c': // make plot of solution
+                    chart = true;
+                    break;
+                case 'd': // make service dependency graph
+                    depgraph = true;
+                    break;
+                case 'r': // random search, size of the neighborhood
+                    neighbor = atoi(argv[++a]);
+                    break;
+                case 'e': // neighborhood size up to which the trail engine is used
+                    IterativeSearch::trail_threshold = atoi(argv[++a]);
+                    break;
+                case 'k': // number of candidate machines per moved process
+                    IterativeSearch::candidate_count = atoi(argv[++a]);
+                    break;
+                case 'T': // number of worker threads
+                    threads = std::max(1, atoi(argv[++a]));
+                    break;
+                case 'u': // aimed success rate of the neighborhood controllers
+                    NeighborhoodController::target_success = atof(argv[++a]);
+                    break;
+                case 'w': // aimed CPU time per reschedule in milliseconds
+                    NeighborhoodController::target_time = atoi(argv[++a]) / 1000.0;
+                    break;
+                case 'g': // seconds per round of region phases and normal scheduling
+                    region_period = atoi(argv[++a]);
+                    break;
+                case 'P': // helper threads of the pipeline search
+                    pipeline_helpers = atoi(argv[++a]);
+                    break;
+                case 'b': // compare both engines on the given number of random neighborhoods
+                    bench = atoi(argv[++a]);
+                    break;
+                case 'o': // result file
+                    solution_file = argv[++a];
+                    break;
+                case 'n': // team name
+                    std::cout << "J25" << std::endl;
+                    return 0;
+                    break;
+                case 's': // seed
+                    seed = atoi(argv[++a]);
+                    break;
+                default:  // unknown parameter -> quit
+                    std::cerr << "Unknown parameter: " << argv[a] << std::endl;
+                    return 1;
+            }
+        }
+    }
+    
+    // the worker running the pipeline waits while its helpers work, so the
+    // helpers count against the thread limit in place of as many workers
+    pipeline_helpers = std::min(pipeline_helpers, (unsigned int)threads);
+    if (pipeline_helpers > 0)
+        threads = std::max(1, threads - (int)pipeline_helpers + 1);
+    
+    time_t firstdeadline = start + (time_limit/2);
+    TimeBudget deadline = TimeBudget::until(epoch + time_limit - 0.25); // buffer time to write the solution
+    
+    if (model == NULL)
+    {
+        std::cerr << "Model file not given" << std::endl;
+        return 1;
+    }
+    
+    ifstream model_file(model);
+    if (!model_file.good())
+    {
+        std::cerr << "Could not open model file" << std::endl;
+        return 1;
+    }
+    
+    if (initial == NULL)
+    {
+        std::cerr << "Assignment file not given" << std::endl;
+        return 1;
+    }
+    
+    ifstream assignment_file(initial);
+    if (!assignment_file.good())
+    {
+        std::cerr << "Could not open assignment file" << std::endl;
+        return 1;
+    }
+    
+    #ifdef LOGGING
+    std::cerr << "reading instance " << model_file << " ... ";
+    #endif
+    
+    Instance instance(model_file);
+    Assignment initial_state;
+    std::copy(istream_iterator<int>(assignment_file), istream_iterator<int>(), back_inserter(initial_state));
+    instance.setOriginalAssignment(initial_state);
+    
+    #ifdef LOGGING
+    std::cerr << "done" << std::endl;
+    #endif
+    
+    ostream* out = &std::cout;
+    
+    model_file.close();
+    assignment_file.close();
+    
+    if (chart)
+    {
+        Assignment current_state(initial_state);
+        if (current != NULL) {
+            ifstream current_file(current);
+            std::copy(istream_iterator<int>(current_file), istream_iterator<int>(), current_state.begin());
+        }
+        
+        SchedulePlotter::plot(*out, instance, initial_state, current_state);
+    }
+    else if (depgraph)
+    {
+        std::cout << "digraph {" << std::endl;
+        for (unsigned int s = 0; s < instance.service.size(); ++s)
+        {
+            for (unsigned int d = 0; d < instance.service[s].depends_on.size(); ++d)
+            {
+                std::cout << s << " -> " << instance.service[s].depends_on[d] << ";" << std::endl;
+            }
+        }
+        std::cout << "graph [ file = \"" << model << "\" ]" << std::endl << "}" << std::endl;
+    }
+    else if (bench > 0)
+    {
+        ReAssignment state;
+        instance.reorderResources();
+        instance.setAssignment(initial_state, &state);
+        
+        benchmark(state, bench, neighbor > 0 ? neighbor : 7, seed);
+    }
+    else
+    {
+        #ifdef LOGGING
+        std::cerr << "Setup space ... ";
+        #endif
+        
+        ReAssignment initial_solution;
+        instance.reorderResources();
+        instance.setAssignment(initial_state, &initial_solution);
+        
+        global_best = new Incumbent(initial_solution, threads);
+        write_counter = 0;
+        
+        // worker data, every worker fixes the same processes in its own ProcessFixing
+        vector<threadworkdata> data(threads);
+        vector<TaskDeque*> queues(threads);
+        for (int w = 0; w < threads; w++) {
+            queues[w] = new TaskDeque;
+            
+            data[w].worker = w;
+            data[w].seed = seed;
+            data[w].queues = &queues;
+            data[w].instancep = &instance;
+            data[w].fixing = new ProcessFixing(instance);
+            data[w].costs = new ProcessCostIndex;
+            data[w].start = start;
+            data[w].epoch = epoch;
+            data[w].deadline = deadline;
+            data[w].solution_file = solution_file;
+            data[w].manage_process_fixing = true;
+            data[w].improvements = 0;
+            data[w].gain = 0;
+            data[w].stolen = 0;
+            data[w].best = new ReAssignment;
+            data[w].version = 0;
+            instance.setAssignment(initial_state, data[w].best);
+            addSearches(data[w]);
+        }
+        
+        vector<pthread_t> iThreadIds(threads);
+        for (int w = 0; w < threads; w++) {
+            int rv = pthread_create(&iThreadIds[w], NULL, &threadwork, &data[w]);
+            
+            #ifdef LOGGING
+            if (rv < 0) printf("error creating thread.\n");
+            #endif
+        }
+        
+        int i, status;
+        for (i = 0; i < threads; i++) {
+            status = pthread_join(iThreadIds[i],NULL);
+            #ifdef LOGGING
+            if (status != 0) printf("error in thread %d with id %d\n", i, (int)iThreadIds[i]);
+            else printf(" thread %d with id %d stopped without errors\n", i, (int)iThreadIds[i]);
+            #endif
+        }
+        
+        // thread scaling report, the rate per thread compared between runs with different -T shows the speedup
+        long long improvement = initial_solution.getCost() - global_best->getCost();
+        double rate = improvement / std::max(TimeBudget::now() - epoch, 0.001);
+        std::cerr << "Scaling: " << threads << " threads, " << sysconf(_SC_NPROCESSORS_ONLN) << " cores, improvement " << improvement
+            << ", " << rate << " per second, " << rate / std::min((long)threads, sysconf(_SC_NPROCESSORS_ONLN)) << " per second and core" << std::endl;
+        for (int w = 0; w < threads; w++) {
+            std::cerr << "Worker " << w + 1 << ": " << data[w].improvements << " improvements, " << data[w].gain << " gain, " << data[w].stolen << " tasks stolen" << std::endl;
+            
+            delete data[w].best;
+            delete data[w].fixing;
+            delete data[w].costs;
+            delete data[w].scheduler;
+            for (unsigned int k = 0; k < data[w].searches.size(); ++k)
+                delete data[w].searches[k];
+            delete queues[w];
+        }
+        
+        // write final solution to file
+        ReAssignment* best = global_best->acquire(0);
+        std::cerr << "Final result: " << best->load_cost << " " << best->balance_cost << " " << best->process_moves << " " << best->machine_moves << std::endl;
+        print(solution_file, best);
+        delete best;
+        delete global_best;
+        
+    }
+    
+    return 0;
+}